@@ -0,0 +1,91 @@
+/**
+ *  comparesort.cpp
+ *
+ *  Micro-benchmark for comparing objects of C++ classes, like usort() does
+ *  with the <=> operator. One class uses the default comparison (by the
+ *  properties), the other one implements __compare(). Build and run it
+ *  against two versions of the library to compare the cost of sorting.
+ */
+
+/**
+ *  Libraries used.
+ */
+#include <phpcpp.h>
+
+/**
+ *  Class without a __compare() method, objects are compared by their properties
+ */
+class PlainNumber : public Php::Base
+{
+public:
+    /**
+     *  PHP constructor
+     *  @param  params
+     */
+    void __construct(Php::Parameters &params)
+    {
+        // store the number in the property
+        (*this)["value"] = params[0];
+    }
+};
+
+/**
+ *  Class with a __compare() method that compares the numbers in C++
+ */
+class CustomNumber : public Php::Base
+{
+private:
+    /**
+     *  The number
+     *  @var int64_t
+     */
+    int64_t _value = 0;
+
+public:
+    /**
+     *  PHP constructor
+     *  @param  params
+     */
+    void __construct(Php::Parameters &params)
+    {
+        // store the number
+        _value = params[0];
+    }
+
+    /**
+     *  Compare with a different object
+     *  @param  that
+     *  @return int
+     */
+    int __compare(const CustomNumber &that) const
+    {
+        return _value < that._value ? -1 : _value > that._value ? 1 : 0;
+    }
+};
+
+// Symbols are exported according to the "C" language
+extern "C"
+{
+    // export the "get_module" function that will be called by the Zend engine
+    PHPCPP_EXPORT void *get_module()
+    {
+        // create extension
+        static Php::Extension extension("comparesort","1.0");
+
+        // the class that is compared by its properties
+        Php::Class<PlainNumber> plain("PlainNumber");
+        plain.method<&PlainNumber::__construct>("__construct", { Php::ByVal("value", Php::Type::Numeric) });
+        plain.property("value", 0);
+
+        // the class that implements __compare()
+        Php::Class<CustomNumber> custom("CustomNumber");
+        custom.method<&CustomNumber::__construct>("__construct", { Php::ByVal("value", Php::Type::Numeric) });
+
+        // add the classes to the extension
+        extension.add(std::move(plain));
+        extension.add(std::move(custom));
+
+        // return the extension module
+        return extension.module();
+    }
+}
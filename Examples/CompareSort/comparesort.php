@@ -0,0 +1,38 @@
+<?php
+/**
+ *  comparesort.php
+ *
+ *  Runs the object comparison micro-benchmark. Run it once with the library
+ *  before and once after a change to compare the results.
+ */
+
+/**
+ *  Sort an array of objects of a class with usort() and the <=> operator,
+ *  and return the number of seconds it took
+ *  @param  string  $class
+ *  @param  int     $count
+ *  @return float
+ */
+function benchmark($class, $count)
+{
+    // create the objects (with the same pseudo random numbers on every run)
+    mt_srand(1);
+    $objects = array();
+    for ($i = 0; $i < $count; $i++) $objects[] = new $class(mt_rand());
+
+    // sort them
+    $start = microtime(true);
+    usort($objects, function($a, $b) { return $a <=> $b; });
+    return microtime(true) - $start;
+}
+
+/**
+ *  Number of objects to sort
+ */
+$count = isset($argv[1]) ? intval($argv[1]) : 1000000;
+
+/**
+ *  Run the benchmark for both classes
+ */
+printf("default comparison: %.3f seconds for %d objects\n", benchmark("PlainNumber", $count), $count);
+printf("__compare():        %.3f seconds for %d objects\n", benchmark("CustomNumber", $count), $count);
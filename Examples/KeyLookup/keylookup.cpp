@@ -0,0 +1,70 @@
+/**
+ *  keylookup.cpp
+ *
+ *  Micro-benchmark for looking up array elements by a string key from C++,
+ *  like value["key"]. Build and run it against two versions of the library
+ *  to compare the cost of the lookups.
+ */
+
+/**
+ *  Libraries used.
+ */
+#include <phpcpp.h>
+#include <chrono>
+
+/**
+ *  keylookup_benchmark($array, $key, $iterations)
+ *
+ *  Looks up the key in the array the given number of times, and returns the
+ *  average number of nanoseconds per lookup
+ *
+ *  @param  params
+ *  @return Php::Value
+ */
+Php::Value keylookup_benchmark(Php::Parameters &params)
+{
+    // the array, the key and the number of iterations
+    const Php::Value &array = params[0];
+    std::string key = params[1];
+    int64_t iterations = params.size() > 2 ? params[2].numericValue() : 1000000;
+
+    // we count the number of found elements, so the compiler can not skip the lookups
+    int64_t found = 0;
+
+    // start timing
+    auto start = std::chrono::steady_clock::now();
+
+    // do the lookups (with a literal key, and with a key from a variable)
+    for (int64_t i = 0; i < iterations; ++i)
+    {
+        if (array.contains(key)) found += 1;
+        if (!array.get(key).isNull()) found += 1;
+        if (!array["key"].isNull()) found += 1;
+    }
+
+    // stop timing
+    auto stop = std::chrono::steady_clock::now();
+
+    // nothing to report if there were no iterations
+    if (iterations <= 0 || found < 0) return 0.0;
+
+    // average time per lookup
+    return std::chrono::duration<double, std::nano>(stop - start).count() / (iterations * 3);
+}
+
+// Symbols are exported according to the "C" language
+extern "C"
+{
+    // export the "get_module" function that will be called by the Zend engine
+    PHPCPP_EXPORT void *get_module()
+    {
+        // create extension
+        static Php::Extension extension("keylookup","1.0");
+
+        // add function to extension
+        extension.add<keylookup_benchmark>("keylookup_benchmark");
+
+        // return the extension module
+        return extension.module();
+    }
+}
@@ -0,0 +1,18 @@
+<?php
+/**
+ *  keylookup.php
+ *
+ *  Runs the key lookup micro-benchmark. Run it once with the library
+ *  before and once after a change to compare the results.
+ */
+
+/**
+ *  An array with a couple of string keys
+ */
+$array = array("key" => 1, "another" => 2, "something" => 3, "a_somewhat_longer_key_name" => 4);
+
+/**
+ *  Run the benchmark for a short and a long key
+ */
+printf("short key: %.1f ns per lookup\n", keylookup_benchmark($array, "key", 1000000));
+printf("long key:  %.1f ns per lookup\n", keylookup_benchmark($array, "a_somewhat_longer_key_name", 1000000));
@@ -38,6 +38,23 @@ const int Private   =   0x04;
 const int Const     =   0;
 #endif
 
+/**
+ *  Class option for a compact object layout (this is not a zend flag, so we
+ *  picked a bit that is not used by any of the modifiers above)
+ */
+const int Compact   =   0x40000000;
+
+/**
+ *  Class option for properties that are initialized on first access (this
+ *  is not a zend flag either)
+ */
+const int LazyProperties    =   0x20000000;
+
+/**
+ *  Class option to remember the values of the properties with callbacks
+ */
+const int SnapshotProperties    =   0x10000000;
+
 /**
  *  Modifiers that are supported for methods and properties
  */
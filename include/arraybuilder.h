@@ -0,0 +1,109 @@
+/**
+ *  ArrayBuilder.h
+ *
+ *  Helper class for building an array of which the (approximate) size is
+ *  known in advance. Filling a Php::Array with set() calls makes the hash
+ *  table grow step by step, with a rehash every time its size is doubled.
+ *  The builder allocates the table at its final size right away, and
+ *  writes the elements straight into it:
+ *
+ *      Php::ArrayBuilder builder(records.size());
+ *      for (auto &record : records) builder.append(convert(record));
+ *      return builder.value();
+ *
+ *  As long as only append() is used (or set() with sequential indexes) the
+ *  result is a packed array. Values that are passed as rvalue are moved
+ *  into the array, without changing their refcount.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT ArrayBuilder
+{
+private:
+    /**
+     *  The array that is being built
+     *  @var Value
+     */
+    Value _array;
+
+public:
+    /**
+     *  Constructor
+     *  @param  size        Expected number of elements
+     */
+    ArrayBuilder(size_t size = 0);
+
+    /**
+     *  The builder can not be copied
+     *  @param  that
+     */
+    ArrayBuilder(const ArrayBuilder &that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~ArrayBuilder() = default;
+
+    /**
+     *  Add an element to the end of the array
+     *  @param  value
+     *  @return ArrayBuilder
+     *  @throws Error       When the next index is already occupied
+     */
+    ArrayBuilder &append(const Value &value);
+    ArrayBuilder &append(Value &&value);
+
+    /**
+     *  Set an element with a numeric key
+     *  @param  index
+     *  @param  value
+     *  @return ArrayBuilder
+     */
+    ArrayBuilder &set(int64_t index, const Value &value);
+    ArrayBuilder &set(int64_t index, Value &&value);
+
+    /**
+     *  Set an element with a string key (numeric strings are turned into
+     *  numeric keys, like PHP does)
+     *  @param  key
+     *  @param  size
+     *  @param  value
+     *  @return ArrayBuilder
+     */
+    ArrayBuilder &set(const char *key, size_t size, const Value &value);
+    ArrayBuilder &set(const char *key, size_t size, Value &&value);
+    ArrayBuilder &set(const std::string &key, const Value &value) { return set(key.data(), key.size(), value); }
+    ArrayBuilder &set(const std::string &key, Value &&value) { return set(key.data(), key.size(), std::move(value)); }
+
+    /**
+     *  Number of elements that have been added so far
+     *  @return size_t
+     */
+    size_t size() const;
+
+    /**
+     *  Retrieve the array that was built (the builder holds a new, empty
+     *  array afterwards)
+     *  @return Value
+     */
+    Value value();
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -69,6 +69,24 @@ Value call(const char *name, Params&&... params)
     return function(std::forward<Params>(params)...);
 }
 
+/**
+ *  Functions that are implemented natively on top of the zend engine (for
+ *  values of an unexpected type, most of these fall back to calling the PHP
+ *  function, so that the same warnings and errors are reported)
+ */
+extern PHPCPP_EXPORT    Value count(const Value &value);
+extern PHPCPP_EXPORT    Value strlen(const Value &value);
+extern PHPCPP_EXPORT    Value array_keys(const Value &value);
+extern PHPCPP_EXPORT    Value array_values(const Value &value);
+extern PHPCPP_EXPORT    Value array_push(Value &array, const Value &value);
+extern PHPCPP_EXPORT    Value array_merge(const Value &array1, const Value &array2);
+extern PHPCPP_EXPORT    Value array_slice(const Value &array, int64_t offset, const Value &length = nullptr, bool preserve_keys = false);
+extern PHPCPP_EXPORT    Value array_search(const Value &needle, const Value &haystack, bool strict = false);
+extern PHPCPP_EXPORT    Value in_array(const Value &needle, const Value &haystack, bool strict = false);
+extern PHPCPP_EXPORT    Value implode(const char *glue, size_t size, const Value &pieces);
+static inline           Value implode(const char *glue, const Value &pieces) { return implode(glue, ::strlen(glue), pieces); }
+static inline           Value implode(const std::string &glue, const Value &pieces) { return implode(glue.data(), glue.size(), pieces); }
+
 /**
  *  Long list of simply-forwarded function calls
  *
@@ -88,17 +106,12 @@ static inline Value array_key_exists(const Value &key, const Value &array) { ret
 static inline Value array_key_exists(int key, const Value &array) { return array.contains(key); }
 static inline Value array_key_exists(const char *key, const Value &array) { return array.contains(key); }
 static inline Value array_key_exists(const std::string &key, const Value &array) { return array.contains(key); }
-static inline Value array_keys(const Value &value) { return call("array_keys", value); }
-static inline Value array_push(const Value &array, const Value &value) { return call("array_push", array, value); }
-static inline Value array_values(const Value &value) { return call("array_values", value); }
-static inline Value count(const Value &value) { return call("count", value); }
 static inline Value echo(const char *input) { out << input; return nullptr; }
 static inline Value echo(const std::string &input) { out << input; return nullptr; }
 static inline Value empty(const Value &value) { return value.isNull() || !value.boolValue(); }
 static inline Value empty(const HashMember<std::string> &member) { return !member.exists() || empty(member.value()); }
 static inline Value empty(const HashMember<int> &member) { return !member.exists() || empty(member.value()); }
 static inline Value is_array(const Value &value) { return value.isArray(); }
-static inline Value strlen(const Value &value) { return call("strlen", value); }
 static inline void  unset(const HashMember<std::string> &member) { member.unset(); }
 static inline void  unset(const HashMember<int> &member) { member.unset(); }
 static inline void  unset(const HashMember<Value> &member) { member.unset(); }
@@ -120,7 +133,7 @@ static inline IniValue ini_get_orig(const char* name) { return IniValue(name, tr
 /**
  *  Define the isset function
  */
-static inline Value isset(const Value &value) { return call("isset", value); }
+static inline Value isset(const Value &value) { return !value.isNull(); }
 static inline Value isset(const HashMember<std::string> &member) { return member.exists() && isset(member.value()); }
 static inline Value isset(const HashMember<int> &member) { return member.exists() && isset(member.value()); }
 static inline Value isset(const HashMember<Value> &member) { return member.exists() && isset(member.value()); }
@@ -0,0 +1,131 @@
+/**
+ *  CallableHandle.h
+ *
+ *  Handle to a PHP function, method or closure that is resolved only once,
+ *  and that can be called many times after that. Calling a function through
+ *  Php::call() or Php::Value::operator() requires that the function is looked
+ *  up by its name on every call, which is avoided with this class.
+ *
+ *  The handle can only be used during the request in which it was created
+ *  (user space functions and objects do not outlive the request).
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Forward declarations
+ */
+struct _zend_fcall_info_cache;
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT CallableHandle
+{
+private:
+    /**
+     *  The callable (this also keeps the object alive for method calls)
+     *  @var    Value
+     */
+    Value _callable;
+
+    /**
+     *  The resolved function, or nullptr if it could not be resolved
+     *  (or if it is resolved on every call, for methods handled by __call())
+     *  @var    zend_fcall_info_cache
+     */
+    struct _zend_fcall_info_cache *_cache = nullptr;
+
+    /**
+     *  Is the callable valid?
+     *  @var    bool
+     */
+    bool _valid = false;
+
+    /**
+     *  Resolve the callable
+     */
+    void resolve();
+
+public:
+    /**
+     *  Constructor
+     *  @param  callable    Anything that can be called: a function name, a closure,
+     *                      an invokable object or an array with an object and method
+     */
+    CallableHandle(const Value &callable);
+
+    /**
+     *  Constructor for a method of an object (or a static method of a class)
+     *  @param  object      The object or the name of the class
+     *  @param  method      Name of the method
+     */
+    CallableHandle(const Value &object, const char *method);
+
+    /**
+     *  No copying (the cache can not be shared)
+     *  @param  that
+     */
+    CallableHandle(const CallableHandle &that) = delete;
+
+    /**
+     *  Move constructor
+     *  @param  that
+     */
+    CallableHandle(CallableHandle &&that) _NOEXCEPT;
+
+    /**
+     *  Destructor
+     */
+    virtual ~CallableHandle();
+
+    /**
+     *  Is this a valid callable?
+     *  @return bool
+     */
+    bool valid() const { return _valid; }
+
+    /**
+     *  Call the function
+     *  @return Value
+     */
+    Value operator()() const { return exec(0, nullptr); }
+
+    /**
+     *  Call the function with a number of arguments
+     *  @param  args        The arguments
+     *  @return Value
+     */
+    template <typename ...Args>
+    Value operator()(Args&&... args) const
+    {
+        // store arguments
+        Value vargs[] = { static_cast<Value>(args)... };
+
+        // call the function
+        return exec(sizeof...(Args), vargs);
+    }
+
+    /**
+     *  Call the function with an array of arguments
+     *  @param  argc        Number of arguments
+     *  @param  argv        The arguments
+     *  @return Value
+     */
+    Value exec(int argc, Value argv[]) const;
+};
+
+/**
+ *  End of namespace
+ */
+}
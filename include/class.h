@@ -31,7 +31,16 @@ public:
      *  Constructor
      *
      *  The flags can be a combination of Php::Final and Php::Abstract.
-     *  If no flags are set, a regular public class will be formed.
+     *  If no flags are set, a regular public class will be formed. With the
+     *  Php::Compact option, the C++ object is stored in the same block of
+     *  memory as the PHP object. With the Php::LazyProperties option, the
+     *  declared properties of an object are only initialized when they are
+     *  accessed for the first time (or when the object is dumped, serialized,
+     *  iterated over or compared). With the Php::SnapshotProperties option,
+     *  the values of the properties with callbacks are remembered when the
+     *  object is exported (var_dump, json_encode, array cast) until one of
+     *  its properties is written, so only use this for objects of which the
+     *  getters do not depend on state that is modified by the methods.
      *
      *  @param  name        Name of the class
      *  @param  flags       Accessibility flags
@@ -75,19 +84,27 @@ public:
     template <void  (T::*callback)()                            >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <Value (T::*callback)()                            >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <void  (T::*callback)(Parameters &params)          >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
+    template <void  (T::*callback)(ParameterView &params)       >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <Value (T::*callback)(Parameters &params)          >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
+    template <Value (T::*callback)(ParameterView &params)       >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <void  (T::*callback)()                            >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <Value (T::*callback)()                            >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <void  (T::*callback)(Parameters &params)          >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
+    template <void  (T::*callback)(ParameterView &params)       >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <Value (T::*callback)(Parameters &params)          >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
+    template <Value (T::*callback)(ParameterView &params)       >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <void  (T::*callback)()                    const   >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <Value (T::*callback)()                    const   >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <void  (T::*callback)(Parameters &params)  const   >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
+    template <void  (T::*callback)(ParameterView &params) const >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <Value (T::*callback)(Parameters &params)  const   >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
+    template <Value (T::*callback)(ParameterView &params) const >   Class<T> &method(const char *name,  int flags,  const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, flags,  args); return *this; }
     template <void  (T::*callback)()                    const   >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <Value (T::*callback)()                    const   >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <void  (T::*callback)(Parameters &params)  const   >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
+    template <void  (T::*callback)(ParameterView &params) const >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
     template <Value (T::*callback)(Parameters &params)  const   >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
+    template <Value (T::*callback)(ParameterView &params) const >   Class<T> &method(const char *name,              const Arguments &args = {})  { ClassBase::method(name, &ZendCallable::invoke<T, callback>, Public, args); return *this; }
 
     /**
      *  Add a static method to a class
@@ -112,11 +129,40 @@ public:
     template <void  (*callback)()                               >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
     template <Value (*callback)()                               >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
     template <void  (*callback)(Parameters &parameters)         >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
+    template <void  (*callback)(ParameterView &parameters)      >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
     template <Value (*callback)(Parameters &parameters)         >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
+    template <Value (*callback)(ParameterView &parameters)      >   Class<T> &method(const char *name, int flags,   const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | flags,  args); return *this; }
     template <void  (*callback)()                               >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
     template <Value (*callback)()                               >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
     template <void  (*callback)(Parameters &parameters)         >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
+    template <void  (*callback)(ParameterView &parameters)      >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
     template <Value (*callback)(Parameters &parameters)         >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
+    template <Value (*callback)(ParameterView &parameters)      >   Class<T> &method(const char *name,              const Arguments &args = {}) { ClassBase::method(name, &ZendCallable::invoke<callback>, Static | Public, args); return *this; }
+
+    /**
+     *  Add a method or static method with an arbitrary signature to the class
+     *
+     *  The arguments are read from PHP and converted to the types in the
+     *  signature. If no argument specification is passed, it is derived
+     *  from the signature too:
+     *
+     *      myClass.method<decltype(&MyClass::myMethod), &MyClass::myMethod>("myMethod");
+     *
+     *  With C++17 the type can be omitted: myClass.method<&MyClass::myMethod>("myMethod");
+     *
+     *  @param  name        Name of the method
+     *  @param  flags       Optional flags
+     *  @param  args        Argument descriptions
+     *  @return Class       Same object to allow chaining
+     */
+    template <typename F, F callback> Class<T> &method(const char *name, int flags = Public) { return method<F>(name, &Signature<F>::template invoke<callback>, Signature<F>::flags() | flags, typename SignatureSequence<Signature<F>::size>::type()); }
+    template <typename F, F callback> Class<T> &method(const char *name, int flags, const Arguments &args) { ClassBase::method(name, &Signature<F>::template invoke<callback>, Signature<F>::flags() | flags, args); return *this; }
+    template <typename F, F callback> Class<T> &method(const char *name, const Arguments &args) { ClassBase::method(name, &Signature<F>::template invoke<callback>, Signature<F>::flags() | Public, args); return *this; }
+#if __cplusplus >= 201703L
+    template <auto callback, typename = std::enable_if_t<SignatureTyped<decltype(callback)>::value>> Class<T> &method(const char *name, int flags = Public) { return method<decltype(callback), callback>(name, flags); }
+    template <auto callback, typename = std::enable_if_t<SignatureTyped<decltype(callback)>::value>> Class<T> &method(const char *name, int flags, const Arguments &args) { return method<decltype(callback), callback>(name, flags, args); }
+    template <auto callback, typename = std::enable_if_t<SignatureTyped<decltype(callback)>::value>> Class<T> &method(const char *name, const Arguments &args) { return method<decltype(callback), callback>(name, args); }
+#endif
 
     /**
      *  Add a regular method to the class
@@ -124,7 +170,9 @@ public:
      *  DEPRECATED
      *
      *  Instead of these functions you should use the templated versions
-     *  defined above.
+     *  defined above. Those get a handler of their own, while methods that
+     *  are registered with these functions share a handler that has to look
+     *  up the method on every call.
      *
      *  The method will be accessible as one of the class methods in your PHP
      *  code. When the method is called, it will automatically be forwarded
@@ -303,7 +351,41 @@ public:
     template<typename CLASS>
     Class<T> &extends(const Class<CLASS> &base) { ClassBase::extends(base); return *this; }
 
+    /**
+     *  Keep the memory of the C++ objects in a pool
+     *
+     *  The memory is allocated in slabs that hold a number of objects, and
+     *  the memory of destructed objects is reused for new objects. This
+     *  saves allocations for classes of which many short-lived instances
+     *  are created. All slabs are released when the request ends. Pools
+     *  are not used by classes with a compact layout (the memory of those
+     *  objects is owned by zend) and in thread safe builds.
+     *
+     *  @param  count       Number of objects per slab
+     *  @return Class       Same object to allow chaining
+     */
+    Class<T> &pool(size_t count = 64) { ClassBase::pool(count); return *this; }
+
+    /**
+     *  Statistics about the pool, use this to find the right size for the slabs
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const { return ClassBase::statistics(); }
+
 private:
+    /**
+     *  Add a method with an argument specification that is derived from the
+     *  signature of the callback
+     *
+     *  @param  name        Name of the method
+     *  @param  callback    The raw callback
+     *  @param  flags       Flags
+     *  @param  indices     Indices of the arguments
+     *  @return Class       Same object to allow chaining
+     */
+    template <typename F, size_t... I>
+    Class<T> &method(const char *name, ZendCallback callback, int flags, SignatureIndices<I...> indices) { ClassBase::method(name, callback, flags, { ByVal(Signature<F>::name(I), Signature<F>::type(I))... }); return *this; }
+
     /**
      *  Method to create the object if it is default constructable
      *  @param  orig
@@ -330,6 +412,32 @@ private:
         return nullptr;
     }
 
+    /**
+     *  Method to create the object in place if it is default constructable
+     *  @param  address
+     *  @return Base*
+     */
+    template <typename X = T>
+    typename std::enable_if<std::is_default_constructible<X>::value, Base*>::type
+    static maybeConstruct(void *address)
+    {
+        // create a new instance
+        return new (address) X();
+    }
+
+    /**
+     *  Method to create the object in place if it is not default constructable
+     *  @param  address
+     *  @return Base*
+     */
+    template <typename X = T>
+    typename std::enable_if<!std::is_default_constructible<X>::value, Base*>::type
+    static maybeConstruct(void *address)
+    {
+        // create empty instance
+        return nullptr;
+    }
+
     /**
      *  Construct a new instance of the object
      *  @return Base
@@ -340,6 +448,28 @@ private:
         return maybeConstruct<T>();
     }
 
+    /**
+     *  Construct a new instance of the object in memory that is already allocated
+     *  @param  address
+     *  @return Base
+     */
+    virtual Base* construct(void *address) const override
+    {
+        // construct an instance
+        return maybeConstruct<T>(address);
+    }
+
+    /**
+     *  Number of bytes needed to construct the object in place (the memory that
+     *  is allocated by zend is only aligned to pointer size, so over-aligned
+     *  classes can not be stored in place)
+     *  @return size_t
+     */
+    virtual size_t size() const override
+    {
+        return alignof(T) <= alignof(void*) ? sizeof(T) : 0;
+    }
+
     /**
      *  Method to clone the object if it is copy constructable
      *  @param  orig
@@ -366,6 +496,34 @@ private:
         return nullptr;
     }
 
+    /**
+     *  Method to clone the object in place if it is copy constructable
+     *  @param  orig
+     *  @param  address
+     *  @return Base*
+     */
+    template <typename X = T>
+    typename std::enable_if<std::is_copy_constructible<X>::value, Base*>::type
+    static maybeClone(X *orig, void *address)
+    {
+        // create a new instance
+        return new (address) X(*orig);
+    }
+
+    /**
+     *  Method to clone the object in place if it is not copy constructable
+     *  @param  orig
+     *  @param  address
+     *  @return Base*
+     */
+    template <typename X = T>
+    typename std::enable_if<!std::is_copy_constructible<X>::value, Base*>::type
+    static maybeClone(X *orig, void *address)
+    {
+        // impossible return null
+        return nullptr;
+    }
+
     /**
      *  Is this a clonable class?
      *  @return bool
@@ -386,6 +544,18 @@ private:
         return maybeClone<T>((T*)orig);
     }
 
+    /**
+     *  Construct a clone in memory that is already allocated
+     *  @param  orig
+     *  @param  address
+     *  @return Base
+     */
+    virtual Base *clone(Base *orig, void *address) const override
+    {
+        // maybe clone it (if the class has a copy constructor)
+        return maybeClone<T>((T*)orig, address);
+    }
+
     /**
      *  Is this class traversable?
      *  @return bool
@@ -416,6 +586,39 @@ private:
         return std::is_base_of<Countable,T>::value;
     }
 
+    /**
+     *  Helper functions to check whether T overrides a magic method: if it
+     *  does not, the member pointer &T::__method still refers to Base
+     *  @return bool
+     */
+    template <typename M> static constexpr bool overridden(M Base::*) { return false; }
+    template <typename M, typename C> static constexpr bool overridden(M C::*) { return true; }
+
+    /**
+     *  Bitmask of the magic methods that are overridden and the interfaces
+     *  that are implemented (this is a compile time constant)
+     *  @return int
+     */
+    virtual int magic() const override
+    {
+        return (overridden(&T::__get)       ? MagicGet       : 0)
+             | (overridden(&T::__set)       ? MagicSet       : 0)
+             | (overridden(&T::__isset)     ? MagicIsset     : 0)
+             | (overridden(&T::__unset)     ? MagicUnset     : 0)
+             | (overridden(&T::__call)      ? MagicCall      : 0)
+             | (HasCallStatic<T>::value     ? MagicCallStatic : 0)
+             | (overridden(&T::__invoke)    ? MagicInvoke    : 0)
+             | (overridden(&T::__compare)   ? MagicCompare   : 0)
+             | (overridden(&T::__toString)  ? MagicToString  : 0)
+             | (overridden(&T::__toInteger) ? MagicToInteger : 0)
+             | (overridden(&T::__toFloat)   ? MagicToFloat   : 0)
+             | (overridden(&T::__toBool)    ? MagicToBool    : 0)
+             | (std::is_base_of<Countable, T>::value   ? MagicCount       : 0)
+             | (std::is_base_of<ArrayAccess, T>::value ? MagicArrayAccess : 0)
+             | (std::is_base_of<TypedArrayBase, T>::value ? MagicTypedArray : 0)
+             | (overridden(&T::__clone)     ? MagicClone     : 0);
+    }
+
     /**
      *  Call the __clone method
      *  @param  base
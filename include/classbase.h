@@ -117,6 +117,19 @@ public:
     virtual Base *construct()       const { return nullptr; }
     virtual Base *clone(Base *orig) const { return nullptr; }
 
+    /**
+     *  Construct a new instance (or a clone) in memory that was already allocated,
+     *  and the number of bytes that is needed for that (zero when the object can
+     *  not be constructed in place). This is used for classes with a compact
+     *  layout and for classes with a pool
+     *  @param  address
+     *  @param  orig
+     *  @return Base
+     */
+    virtual Base *construct(void *address) const { return nullptr; }
+    virtual Base *clone(Base *orig, void *address) const { return nullptr; }
+    virtual size_t size() const { return 0; }
+
     /**
      *  Methods to check if a certain interface is overridden, or a copy
      *  constructor is available
@@ -127,6 +140,41 @@ public:
     virtual bool countable()    const { return false; }
     virtual bool clonable()     const { return false; }
 
+    /**
+     *  Magic methods and interfaces that can be implemented by a class, the
+     *  object handlers that forward to these methods are only installed when
+     *  needed
+     */
+    enum Magic {
+        MagicGet            = 0x0001,
+        MagicSet            = 0x0002,
+        MagicIsset          = 0x0004,
+        MagicUnset          = 0x0008,
+        MagicCall           = 0x0010,
+        MagicCallStatic     = 0x0020,
+        MagicInvoke         = 0x0040,
+        MagicCompare        = 0x0080,
+        MagicToString       = 0x0100,
+        MagicToInteger      = 0x0200,
+        MagicToFloat        = 0x0400,
+        MagicToBool         = 0x0800,
+        MagicCount          = 0x1000,
+        MagicArrayAccess    = 0x2000,
+        MagicTypedArray     = 0x4000,
+        MagicClone          = 0x8000,
+
+        // all the cast methods
+        MagicCast           = MagicToString | MagicToInteger | MagicToFloat | MagicToBool
+    };
+
+    /**
+     *  Bitmask of the magic methods that are overridden and the interfaces
+     *  that are implemented (by default we assume that they all are, except
+     *  for the typed array storage that must really be there)
+     *  @return int
+     */
+    virtual int magic() const { return ~MagicTypedArray; }
+
     /**
      *  Compare two objects
      *  @param  object1
@@ -304,6 +352,18 @@ protected:
      */
     void extends(const ClassBase &base);
 
+    /**
+     *  Keep the memory of the C++ objects in a pool
+     *  @param  count           Number of objects per slab
+     */
+    void pool(size_t count);
+
+    /**
+     *  Statistics about the pool
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const;
+
 private:
     /**
      *  Pointer to the actual implementation
@@ -7,7 +7,9 @@
  *  the array when the member is modified
  *
  *  You are not supposed to instantiate this class. An instance of it is
- *  created when you call Value::operator[]
+ *  created when you call Value::operator[]. Members for string keys do not
+ *  copy the key, so a member should not outlive the expression in which
+ *  it was created.
  *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2013 Copernica BV
@@ -23,6 +25,13 @@ namespace Php {
  */
 class Value;
 
+/**
+ *  The type in which a member stores its index: string keys are stored as
+ *  a Php::Key that refers to the buffer of the original string
+ */
+template <typename Type> struct HashIndex { using type = Type; };
+template <> struct HashIndex<std::string> { using type = Key; };
+
 /**
  *  Member class
  */
@@ -35,7 +44,7 @@ public:
      *  @param  parent
      *  @param  index
      */
-    HashMember(HashParent *parent, Type index) : _parent(parent), _index(index) {}
+    HashMember(HashParent *parent, const typename HashIndex<Type>::type &index) : _parent(parent), _index(index) {}
 
     /**
      *  Destructor
@@ -167,7 +176,7 @@ public:
      */
     HashMember<std::string> operator[](const std::string &key)
     {
-        return HashMember<std::string>(this, key);
+        return HashMember<std::string>(this, Key(key.data(), key.size()));
     }
 
     /**
@@ -178,7 +187,18 @@ public:
      */
     HashMember<std::string> operator[](const char *key)
     {
-        return HashMember<std::string>(this, key);
+        return HashMember<std::string>(this, Key(key, ::strlen(key)));
+    }
+
+    /**
+     *  Array access operator
+     *  This can be used for accessing associative arrays
+     *  @param  key
+     *  @return HashMember
+     */
+    HashMember<Key> operator[](const Key &key)
+    {
+        return HashMember<Key>(this, key);
     }
 
     /**
@@ -411,6 +431,17 @@ public:
         return exists() && value().contains(key);
     }
 
+    /**
+     *  Check if a certain key exists in the array/object
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const override
+    {
+        // object must exist, and the value must contain the key
+        return exists() && value().contains(key);
+    }
+
     /**
      *  Retrieve the value at a string index
      *  @param  key
@@ -453,6 +484,20 @@ public:
         return value().get(key);
     }
 
+    /**
+     *  Retrieve the value at a key with a precalculated hash
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const override
+    {
+        // return null if it does not exist
+        if (!exists()) return nullptr;
+
+        // ask the value
+        return value().get(key);
+    }
+
     /**
      *  Overwrite the value at a certain string index
      *  @param  key
@@ -460,6 +505,13 @@ public:
      */
     virtual void set(const std::string &key, const Value &value) override
     {
+        // take a reference to the value before the path is separated, so that
+        // assigning (part of) the same array stores a copy instead of a cycle
+        Value copy(value);
+
+        // store the value in place if the path to this member can be resolved
+        if (auto *array = writable()) return update(array, Key(key.data(), key.size()), copy);
+
         // get the current value
         Value current(this->value());
 
@@ -477,6 +529,13 @@ public:
      */
     virtual void set(int index, const Value &value) override
     {
+        // take a reference to the value before the path is separated, so that
+        // assigning (part of) the same array stores a copy instead of a cycle
+        Value copy(value);
+
+        // store the value in place if the path to this member can be resolved
+        if (auto *array = writable()) return update(array, index, copy);
+
         // get the current value
         Value current(this->value());
 
@@ -494,6 +553,37 @@ public:
      */
     virtual void set(const Value &key, const Value &value) override
     {
+        // take a reference to the value before the path is separated, so that
+        // assigning (part of) the same array stores a copy instead of a cycle
+        Value copy(value);
+
+        // store the value in place if the path to this member can be resolved
+        if (auto *array = writable()) return update(array, key, copy);
+
+        // get the current value
+        Value current(this->value());
+
+        // add the value
+        current[key] = value;
+
+        // pass this to the base
+        _parent->set(_index, current);
+    }
+
+    /**
+     *  Overwrite the value at a key with a precalculated hash
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) override
+    {
+        // take a reference to the value before the path is separated, so that
+        // assigning (part of) the same array stores a copy instead of a cycle
+        Value copy(value);
+
+        // store the value in place if the path to this member can be resolved
+        if (auto *array = writable()) return update(array, key, copy);
+
         // get the current value
         Value current(this->value());
 
@@ -578,6 +668,28 @@ public:
         _parent->set(_index, current);
     }
 
+    /**
+     *  Unset a member by a key with a precalculated hash
+     *  @param  key
+     */
+    virtual void unset(const Key &key) override
+    {
+        // if the current property does not even exist, we do not have to add anything
+        if (!exists()) return;
+
+        // get the current value
+        Value current(this->value());
+
+        // skip if the property does not exist
+        if (!current.contains(key)) return;
+
+        // remove the index
+        current.unset(key);
+
+        // pass the new value to the base
+        _parent->set(_index, current);
+    }
+
 protected:
     /**
      *  Protected copy constructor
@@ -603,7 +715,20 @@ private:
      *  The original index
      *  @var Type
      */
-    Type _index;
+    typename HashIndex<Type>::type _index;
+
+    /**
+     *  Retrieve the array that this member refers to for writing in place
+     *  @return struct _zval_struct
+     */
+    virtual struct _zval_struct *writable() override
+    {
+        // the array that holds this member
+        auto *array = _parent->writable();
+
+        // find or add the member in it
+        return array ? element(array, _index) : nullptr;
+    }
 
     /**
      *  Friend classes
@@ -611,6 +736,7 @@ private:
     friend class HashMember<std::string>;
     friend class HashMember<Value>;
     friend class HashMember<int>;
+    friend class HashMember<Key>;
     friend class Base;
     friend class Value;
 };
@@ -623,6 +749,7 @@ private:
  */
 PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<int> &value);
 PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<std::string> &value);
+PHPCPP_EXPORT std::ostream &operator<<(std::ostream &stream, const HashMember<Key> &value);
 
 
 /**
@@ -13,6 +13,12 @@
  *  @copyright 2014 Copernica BV
  */
 
+/**
+ *  Forward declarations
+ */
+struct _zend_array;
+struct _zval_struct;
+
 /**
  *  Set up namespace
  */
@@ -62,6 +68,13 @@ public:
      */
     virtual bool contains(const Value &index) const = 0;
 
+    /**
+     *  Check if a certain key exists in the array/object
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const = 0;
+
     /**
      *  Retrieve the value at a string index
      *  @param  key
@@ -83,6 +96,13 @@ public:
      */
     virtual Value get(const Value &key) const = 0;
 
+    /**
+     *  Retrieve the value at a key with a precalculated hash
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const = 0;
+
     /**
      *  Overwrite the value at a certain string index
      *  @param  key
@@ -104,6 +124,13 @@ public:
      */
     virtual void set(const Value &key, const Value &value) = 0;
 
+    /**
+     *  Overwrite the value at a key with a precalculated hash
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) = 0;
+
     /**
      *  Unset a member by its index
      *  @param  index
@@ -122,6 +149,52 @@ public:
      */
     virtual void unset(const Value &key) = 0;
 
+    /**
+     *  Unset a member by a key with a precalculated hash
+     *  @param  key
+     */
+    virtual void unset(const Key &key) = 0;
+
+    /**
+     *  Retrieve the array that this object refers to, ready to be written
+     *  to in place: the array is separated from other copies, and the object
+     *  is turned into an array if it was not one already. Nested assignments
+     *  like value["x"]["y"] = 10 use this to resolve the whole path with one
+     *  lookup per level, instead of copying and writing back the array at
+     *  every level. Returns nullptr if this is not possible (for objects).
+     *  @return struct _zval_struct
+     */
+    virtual struct _zval_struct *writable() { return nullptr; }
+
+protected:
+    /**
+     *  Find an element by a key with a precalculated hash
+     *  @param  table
+     *  @param  key
+     *  @return struct _zval_struct     The element, or nullptr if it does not exist
+     */
+    static struct _zval_struct *find(struct _zend_array *table, const Key &key);
+
+    /**
+     *  Find or add an element in an array that was returned by writable(),
+     *  and make the element itself writable as well
+     *  @param  array
+     *  @param  index
+     *  @return struct _zval_struct     The element, or nullptr if it can not be written in place
+     */
+    static struct _zval_struct *element(struct _zval_struct *array, int index);
+    static struct _zval_struct *element(struct _zval_struct *array, const Key &key);
+    static struct _zval_struct *element(struct _zval_struct *array, const Value &key);
+
+    /**
+     *  Store an element in an array that was returned by writable()
+     *  @param  array
+     *  @param  index
+     *  @param  value
+     */
+    static void update(struct _zval_struct *array, int index, const Value &value);
+    static void update(struct _zval_struct *array, const Key &key, const Value &value);
+    static void update(struct _zval_struct *array, const Value &key, const Value &value);
 };
 
 /**
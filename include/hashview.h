@@ -0,0 +1,313 @@
+/**
+ *  HashView.h
+ *
+ *  Lightweight, non-owning view on the elements of an array. Iterating over
+ *  a Php::Value with begin() and end() allocates an iterator object on the
+ *  heap, and every step creates new Php::Value objects for the key and the
+ *  value. The iterator of this class lives on the stack, has no virtual
+ *  methods, and gives access to borrowed keys and values that are read
+ *  directly from the hash table:
+ *
+ *      for (auto entry : value.items())
+ *      {
+ *          if (entry.key.isString()) ...
+ *          int64_t number = entry.value.numericValue();
+ *      }
+ *
+ *  The view, its iterators, keys and values are only valid as long as the
+ *  array is not modified or destructed.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Forward declarations
+ */
+struct _zend_array;
+struct _zend_string;
+struct _zval_struct;
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class Value;
+
+/**
+ *  Borrowed key of an array element
+ */
+class PHPCPP_EXPORT KeyView
+{
+private:
+    /**
+     *  The string key (nullptr for numeric keys)
+     *  @var struct _zend_string
+     */
+    struct _zend_string *_string;
+
+    /**
+     *  The numeric key
+     *  @var int64_t
+     */
+    int64_t _index;
+
+public:
+    /**
+     *  Constructor
+     *  @param  string      The string key, or nullptr for a numeric key
+     *  @param  index       The numeric key
+     */
+    KeyView(struct _zend_string *string, int64_t index) : _string(string), _index(index) {}
+
+    /**
+     *  Is this a string key?
+     *  @return bool
+     */
+    bool isString() const { return _string != nullptr; }
+
+    /**
+     *  Is this a numeric key?
+     *  @return bool
+     */
+    bool isNumeric() const { return _string == nullptr; }
+
+    /**
+     *  The numeric key (0 for string keys)
+     *  @return int64_t
+     */
+    int64_t numericValue() const { return _string ? 0 : _index; }
+
+    /**
+     *  Direct access to the buffer of a string key (nullptr for numeric keys)
+     *  @return const char *
+     */
+    const char *rawValue() const;
+
+    /**
+     *  Size of a string key (0 for numeric keys)
+     *  @return size_t
+     */
+    size_t size() const;
+
+    /**
+     *  The key as string (numeric keys are converted)
+     *  @return std::string
+     */
+    std::string stringValue() const;
+
+    /**
+     *  Create a Php::Value object holding the key
+     *  @return Value
+     */
+    Value value() const;
+};
+
+/**
+ *  Borrowed value of an array element
+ */
+class PHPCPP_EXPORT ValueView
+{
+private:
+    /**
+     *  The value (references are already resolved)
+     *  @var struct _zval_struct
+     */
+    struct _zval_struct *_zval;
+
+public:
+    /**
+     *  Constructor
+     *  @param  zval
+     */
+    ValueView(struct _zval_struct *zval) : _zval(zval) {}
+
+    /**
+     *  The type of the value
+     *  @return Type
+     */
+    Type type() const;
+
+    /**
+     *  Check the type of the value
+     *  @return bool
+     */
+    bool isNull() const { return type() == Type::Null; }
+    bool isNumeric() const { return type() == Type::Numeric; }
+    bool isBool() const { return type() == Type::False || type() == Type::True; }
+    bool isString() const { return type() == Type::String; }
+    bool isFloat() const { return type() == Type::Float; }
+    bool isArray() const { return type() == Type::Array; }
+    bool isObject() const { return type() == Type::Object; }
+
+    /**
+     *  Retrieve the value, with the same conversions as the corresponding
+     *  methods in the Value class
+     *  @return int64_t|bool|double|std::string
+     */
+    int64_t numericValue() const;
+    bool boolValue() const;
+    double floatValue() const;
+    std::string stringValue() const;
+
+#if __cplusplus >= 201703L
+    /**
+     *  View on the buffer of a string value (empty for other types)
+     *  @return std::string_view
+     */
+    std::string_view stringView() const { return std::string_view(rawValue(), size()); }
+#endif
+
+    /**
+     *  Direct access to the buffer of a string value (nullptr for other types)
+     *  @return const char *
+     */
+    const char *rawValue() const;
+
+    /**
+     *  Size of a string value (0 for other types)
+     *  @return size_t
+     */
+    size_t size() const;
+
+    /**
+     *  Create a Php::Value object holding the value (this increments the
+     *  refcount, the value is not copied)
+     *  @return Value
+     */
+    Value value() const;
+};
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT HashView
+{
+public:
+    /**
+     *  An element in the array
+     */
+    struct Entry
+    {
+        KeyView key;
+        ValueView value;
+    };
+
+    /**
+     *  The iterator class
+     */
+    class PHPCPP_EXPORT iterator
+    {
+    private:
+        /**
+         *  The hash table
+         *  @var struct _zend_array
+         */
+        struct _zend_array *_table;
+
+        /**
+         *  The position in the hash table
+         *  @var uint32_t
+         */
+        uint32_t _position;
+
+        /**
+         *  The current element (only valid when not at the end)
+         *  @var struct _zval_struct, struct _zend_string, int64_t
+         */
+        struct _zval_struct *_zval = nullptr;
+        struct _zend_string *_string = nullptr;
+        int64_t _index = 0;
+
+        /**
+         *  Move to the first valid element at or after the current position
+         */
+        void seek();
+
+    public:
+        /**
+         *  Constructor
+         *  @param  table       The hash table (may be nullptr)
+         *  @param  position    Start position
+         */
+        iterator(struct _zend_array *table, uint32_t position) : _table(table), _position(position) { seek(); }
+
+        /**
+         *  Increment position
+         *  @return iterator
+         */
+        iterator &operator++()
+        {
+            // move forward, and skip the holes
+            _position += 1;
+            seek();
+            return *this;
+        }
+
+        /**
+         *  Compare with other iterator (over the same table)
+         *  @param  that
+         *  @return bool
+         */
+        bool operator==(const iterator &that) const { return _position == that._position; }
+        bool operator!=(const iterator &that) const { return _position != that._position; }
+
+        /**
+         *  The current element
+         *  @return Entry
+         */
+        Entry operator*() const { return Entry{ KeyView(_string, _index), ValueView(_zval) }; }
+    };
+
+    /**
+     *  Constructor
+     *  @param  table       The hash table (nullptr for an empty view)
+     */
+    HashView(struct _zend_array *table) : _table(table) {}
+
+    /**
+     *  Iterators
+     *  @return iterator
+     */
+    iterator begin() const { return iterator(_table, 0); }
+    iterator end() const;
+
+    /**
+     *  Number of elements
+     *  @return size_t
+     */
+    size_t size() const;
+
+    /**
+     *  Is the array a list: a packed hash table without holes, so that the
+     *  elements are stored in order with keys 0 up to size()-1?
+     *  @return bool
+     */
+    bool isList() const;
+
+    /**
+     *  Is the view empty?
+     *  @return bool
+     */
+    bool empty() const { return size() == 0; }
+
+private:
+    /**
+     *  The hash table
+     *  @var struct _zend_array
+     */
+    struct _zend_array *_table;
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,160 @@
+/**
+ *  Key.h
+ *
+ *  Key for looking up elements in an array by a string, with a hash value
+ *  that is calculated at compile time. Accessing an array with a regular
+ *  string key (value["customer_id"]) means that the key has to be hashed
+ *  on every access, with a Php::Key this work is already done:
+ *
+ *      using Php::operator""_key;
+ *
+ *      int64_t id = value["customer_id"_key];
+ *      value["customer_id"_key] = 123;
+ *
+ *  The hash is calculated in the same way as the Zend engine does, so that
+ *  it can be used for looking up buckets directly. The key does not copy
+ *  the string, so it should only be created from string literals or from
+ *  buffers that outlive the key.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class Key
+{
+private:
+    /**
+     *  The string
+     *  @var const char *
+     */
+    const char *_data;
+
+    /**
+     *  Size of the string
+     *  @var size_t
+     */
+    size_t _size;
+
+    /**
+     *  The hash value
+     *  @var size_t
+     */
+    size_t _hash;
+
+    /**
+     *  Calculate the hash value (the "times 33" algorithm of the Zend
+     *  engine, which also sets the highest bit so that the hash is never 0).
+     *  Keys that are created at runtime are hashed with a loop, in C++11 a
+     *  constexpr function can not hold a loop, so there the constexpr path
+     *  for literals uses recursion instead (one step per character is fine
+     *  for the compiler, but not for the stack at runtime).
+     *  @param  data
+     *  @param  size
+     *  @param  result      Hash value so far
+     *  @return size_t
+     */
+#if __cplusplus >= 201402L
+    static constexpr size_t calculate(const char *data, size_t size)
+#else
+    static size_t calculate(const char *data, size_t size)
+#endif
+    {
+        size_t result = 5381;
+        for (size_t i = 0; i < size; ++i) result = result * 33 + (size_t)data[i];
+        return result | ((size_t)1 << (sizeof(size_t) * 8 - 1));
+    }
+
+#if __cplusplus >= 201402L
+    static constexpr size_t literal(const char *data, size_t size)
+    {
+        return calculate(data, size);
+    }
+#else
+    static constexpr size_t literal(const char *data, size_t size, size_t result = 5381)
+    {
+        return size == 0 ? result | ((size_t)1 << (sizeof(size_t) * 8 - 1)) : literal(data + 1, size - 1, result * 33 + (size_t)*data);
+    }
+#endif
+
+    /**
+     *  Tag to select the constructor for literals
+     */
+    struct Literal {};
+
+    /**
+     *  Constructor for literals, the hash is calculated at compile time
+     *  @param  data
+     *  @param  size
+     */
+    constexpr Key(const char *data, size_t size, Literal) : _data(data), _size(size), _hash(literal(data, size)) {}
+
+    /**
+     *  The literal operator uses the constructor for literals
+     */
+    friend constexpr Key operator""_key(const char *data, size_t size);
+
+public:
+    /**
+     *  Constructor (only constexpr since C++14, in C++11 the hash is then
+     *  calculated at runtime, use a literal for a compile time key)
+     *  @param  data        The string (it is not copied)
+     *  @param  size        Size of the string
+     */
+#if __cplusplus >= 201402L
+    constexpr
+#endif
+    Key(const char *data, size_t size) : _data(data), _size(size), _hash(calculate(data, size)) {}
+
+    /**
+     *  Constructor from a string literal
+     *  @param  data
+     */
+    template <size_t size>
+    constexpr Key(const char (&data)[size]) : Key(data, size - 1, Literal()) {}
+
+    /**
+     *  The string
+     *  @return const char *
+     */
+    constexpr const char *data() const { return _data; }
+
+    /**
+     *  Size of the string
+     *  @return size_t
+     */
+    constexpr size_t size() const { return _size; }
+
+    /**
+     *  The hash value
+     *  @return size_t
+     */
+    constexpr size_t hash() const { return _hash; }
+};
+
+/**
+ *  User defined literal to create a key: "customer_id"_key
+ *  @param  data
+ *  @param  size
+ *  @return Key
+ */
+constexpr Key operator""_key(const char *data, size_t size)
+{
+    return Key(data, size, Key::Literal());
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -24,6 +24,26 @@ extern PHPCPP_EXPORT const int Protected;
 extern PHPCPP_EXPORT const int Private;
 extern PHPCPP_EXPORT const int Const;
 
+/**
+ *  Class option to store the C++ object in the same block of memory as the
+ *  PHP object (this saves allocations for classes with many small instances)
+ */
+extern PHPCPP_EXPORT const int Compact;
+
+/**
+ *  Class option to postpone the initialization of the declared properties
+ *  until they are accessed (this saves time for classes with many instances
+ *  that keep all their state in the C++ object)
+ */
+extern PHPCPP_EXPORT const int LazyProperties;
+
+/**
+ *  Class option to keep a snapshot of the values of the properties with
+ *  callbacks, so that exporting an object again (var_dump, json_encode,
+ *  array cast) does not call all getters again until a property is written
+ */
+extern PHPCPP_EXPORT const int SnapshotProperties;
+
 /**
  *  Modifiers that are supported for methods and properties
  */
@@ -64,6 +64,18 @@ protected:
      */
     Namespace &add(const char *name, ZendCallback function, const Arguments &arguments = {});
 
+    /**
+     *  Add a native function directly to the namespace, with an argument
+     *  specification that is derived from the signature of the callback
+     *
+     *  @param  name        Name of the function
+     *  @param  function    The raw function to add
+     *  @param  indices     Indices of the arguments
+     *  @return Same object to allow chaining
+     */
+    template <typename F, size_t... I>
+    Namespace &add(const char *name, ZendCallback function, SignatureIndices<I...> indices) { return add(name, function, { ByVal(Signature<F>::name(I), Signature<F>::type(I))... }); }
+
     /**
      *  Is the object locked?
      *
@@ -107,6 +119,30 @@ public:
     template <void  (*callback)(Parameters &parameters)>    Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
     template <Value (*callback)()>                          Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
     template <Value (*callback)(Parameters &parameters)>    Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
+    template <void  (*callback)(ParameterView &parameters)> Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
+    template <Value (*callback)(ParameterView &parameters)> Namespace &add(const char *name, const Arguments &arguments = {}) { return add(name, &ZendCallable::invoke<callback>, arguments); }
+
+    /**
+     *  Add a native function with an arbitrary signature to the namespace
+     *
+     *  The arguments are read from PHP and converted to the types in the
+     *  signature. If no argument specification is passed, it is derived
+     *  from the signature too:
+     *
+     *      extension.add<decltype(&myFunction), &myFunction>("myFunction");
+     *
+     *  With C++17 the type can be omitted: extension.add<&myFunction>("myFunction");
+     *
+     *  @param  name        Name of the function
+     *  @param  arguments   Optional argument specification
+     *  @return Same object to allow chaining
+     */
+    template <typename F, F callback> Namespace &add(const char *name) { return add<F>(name, &Signature<F>::template invoke<callback>, typename SignatureSequence<Signature<F>::size>::type()); }
+    template <typename F, F callback> Namespace &add(const char *name, const Arguments &arguments) { return add(name, &Signature<F>::template invoke<callback>, arguments); }
+#if __cplusplus >= 201703L
+    template <auto callback, typename = std::enable_if_t<SignatureTyped<decltype(callback)>::value>> Namespace &add(const char *name) { return add<decltype(callback), callback>(name); }
+    template <auto callback, typename = std::enable_if_t<SignatureTyped<decltype(callback)>::value>> Namespace &add(const char *name, const Arguments &arguments) { return add<decltype(callback), callback>(name, arguments); }
+#endif
 
     /**
      *  Add a native function directly to the namespace
@@ -0,0 +1,165 @@
+/**
+ *  ParameterView.h
+ *
+ *  Lightweight, non-owning view on the parameters that were passed to a
+ *  function or method. Unlike the Php::Parameters class, which copies all
+ *  arguments into a std::vector<Php::Value>, this class reads the arguments
+ *  directly from the call frame of the Zend engine.
+ *
+ *  A view is only valid for the duration of the call: you should not store
+ *  it or keep a pointer to it after the callback has returned.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Forward declarations
+ */
+struct _zend_execute_data;
+struct _zval_struct;
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Forward declarations
+ */
+class Base;
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT ParameterView
+{
+private:
+    /**
+     *  The call frame holding the arguments
+     *  @var struct _zend_execute_data
+     */
+    struct _zend_execute_data *_execute_data;
+
+    /**
+     *  Number of arguments that were passed
+     *  @var uint32_t
+     */
+    uint32_t _size;
+
+    /**
+     *  Retrieve the zval holding a certain argument (references are
+     *  already resolved, and nullptr is returned for out-of-range indexes)
+     *  @param  index
+     *  @return struct _zval_struct
+     */
+    struct _zval_struct *argument(size_t index) const;
+
+public:
+    /**
+     *  Constructor
+     *
+     *  This constructor is called by the library when a callback is invoked,
+     *  extension programmers do not normally have to create a view themselves.
+     *
+     *  @param  execute_data    The call frame
+     */
+    ParameterView(struct _zend_execute_data *execute_data);
+
+    /**
+     *  The view cannot be copied, because it does not own the arguments
+     *  and it should not outlive the call
+     *  @param  that
+     */
+    ParameterView(const ParameterView &that) = delete;
+
+    /**
+     *  Number of arguments
+     *  @return size_t
+     */
+    size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     *  Were no arguments passed?
+     *  @return bool
+     */
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     *  The object that is being called (or nullptr for functions
+     *  and static methods)
+     *  @return Base
+     */
+    Base *object() const;
+
+    /**
+     *  Retrieve a parameter as a Php::Value object. This creates a copy of
+     *  the argument, if you only need a scalar it is better to use one of
+     *  the typed accessors below. For out-of-range indexes a NULL value
+     *  is returned.
+     *  @param  index
+     *  @return Value
+     */
+    Value operator[](size_t index) const;
+
+    /**
+     *  Type of a parameter (Type::Undefined for out-of-range indexes)
+     *  @param  index
+     *  @return Type
+     */
+    Type type(size_t index) const;
+
+    /**
+     *  Typed accessors that read a parameter without wrapping it in a Value
+     *  object first. They apply the same conversions as the corresponding
+     *  methods in the Value class, and return an empty value for
+     *  out-of-range indexes.
+     *  @param  index
+     *  @return int64_t|bool|double|std::string
+     */
+    int64_t numericValue(size_t index) const;
+    bool boolValue(size_t index) const;
+    double floatValue(size_t index) const;
+    std::string stringValue(size_t index) const;
+
+    /**
+     *  Retrieve direct access to the buffer of a string parameter. This
+     *  does not make a copy, but only works if the parameter really is a
+     *  string, for all other types nullptr is returned.
+     *  @param  index
+     *  @return const char *
+     */
+    const char *rawValue(size_t index) const;
+
+    /**
+     *  Size of a string parameter (or 0 if the parameter is not a string)
+     *  @param  index
+     *  @return size_t
+     */
+    size_t rawSize(size_t index) const;
+
+#if __cplusplus >= 201703L
+    /**
+     *  View on the buffer of a string parameter (empty for other types)
+     *  @param  index
+     *  @return std::string_view
+     */
+    std::string_view stringView(size_t index) const { return std::string_view(rawValue(index), rawSize(index)); }
+#endif
+};
+
+/**
+ *  End of namespace
+ */
+}
+
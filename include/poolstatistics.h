@@ -0,0 +1,56 @@
+/**
+ *  PoolStatistics.h
+ *
+ *  Statistics about the pool of memory that is used for the objects of a
+ *  class that was registered with a pool. You can use these numbers to find
+ *  out how large the slabs of the pool should be.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+struct PHPCPP_EXPORT PoolStatistics
+{
+    /**
+     *  Number of objects that are currently alive
+     *  @var    size_t
+     */
+    size_t live = 0;
+
+    /**
+     *  Highest number of objects that were alive at the same time during
+     *  the current request (this is reset when the request ends)
+     *  @var    size_t
+     */
+    size_t peak = 0;
+
+    /**
+     *  Number of objects that were created in the memory of an object
+     *  that was destructed before
+     *  @var    size_t
+     */
+    size_t recycled = 0;
+
+    /**
+     *  Number of slabs that are currently allocated
+     *  @var    size_t
+     */
+    size_t slabs = 0;
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,519 @@
+/**
+ *  Signature.h
+ *
+ *  Helper classes to register functions and methods with a native C++
+ *  signature, like "int64_t add(int64_t a, double b)". The arguments are
+ *  read directly from the call frame and converted to the C++ types, and
+ *  the argument information for the Zend engine is generated from the
+ *  types in the signature.
+ *
+ *  Supported argument types are all integral and floating point types,
+ *  bool, std::string, std::string_view (C++17) and Php::Value. The same
+ *  types can be returned, as well as void and everything else that can be
+ *  converted into a Php::Value.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Dependencies
+ */
+#include <type_traits>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  List of compile time indices (std::index_sequence is only available
+ *  from C++14 onwards, and we want to stay compatible with C++11)
+ */
+template <size_t... I> struct SignatureIndices {};
+template <size_t N, size_t... I> struct SignatureSequence : SignatureSequence<N - 1, N - 1, I...> {};
+template <size_t... I> struct SignatureSequence<0, I...> { using type = SignatureIndices<I...>; };
+
+/**
+ *  Class to convert a single argument to its C++ type, the generic
+ *  implementation is not defined, so that unsupported argument types
+ *  result in a compile error.
+ */
+template <typename T, typename Enable = void>
+class SignatureArgument;
+
+/**
+ *  Booleans
+ */
+template <>
+class SignatureArgument<bool>
+{
+private:
+    /**
+     *  The converted value
+     *  @var bool
+     */
+    bool _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index) : _value(params.boolValue(index)) {}
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::Bool; }
+
+    /**
+     *  Cast to the native type
+     *  @return bool
+     */
+    operator bool () const { return _value; }
+};
+
+/**
+ *  Integral types
+ */
+template <typename T>
+class SignatureArgument<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+{
+private:
+    /**
+     *  The converted value
+     *  @var T
+     */
+    T _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index) : _value(static_cast<T>(params.numericValue(index))) {}
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::Numeric; }
+
+    /**
+     *  Cast to the native type
+     *  @return T
+     */
+    operator T () const { return _value; }
+};
+
+/**
+ *  Floating point types
+ */
+template <typename T>
+class SignatureArgument<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+private:
+    /**
+     *  The converted value
+     *  @var T
+     */
+    T _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index) : _value(static_cast<T>(params.floatValue(index))) {}
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::Float; }
+
+    /**
+     *  Cast to the native type
+     *  @return T
+     */
+    operator T () const { return _value; }
+};
+
+/**
+ *  Strings
+ */
+template <>
+class SignatureArgument<std::string>
+{
+private:
+    /**
+     *  The converted value
+     *  @var std::string
+     */
+    std::string _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index) : _value(params.stringValue(index)) {}
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::String; }
+
+    /**
+     *  Cast to the native type
+     *  @return std::string
+     */
+    operator const std::string & () const { return _value; }
+};
+
+#if __cplusplus >= 201703L
+/**
+ *  String views, these refer directly to the buffer of the zval, unless
+ *  the parameter first had to be converted into a string
+ */
+template <>
+class SignatureArgument<std::string_view>
+{
+private:
+    /**
+     *  Buffer for arguments that are not a string
+     *  @var std::string
+     */
+    std::string _buffer;
+
+    /**
+     *  The view on the string
+     *  @var std::string_view
+     */
+    std::string_view _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index)
+    {
+        // direct access to the buffer of the string
+        auto *buffer = params.rawValue(index);
+
+        // if the argument is a string, we do not have to make a copy
+        if (buffer) _value = std::string_view(buffer, params.rawSize(index));
+
+        // otherwise we convert it into our own buffer
+        else _value = _buffer = params.stringValue(index);
+    }
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::String; }
+
+    /**
+     *  Cast to the native type
+     *  @return std::string_view
+     */
+    operator std::string_view () const { return _value; }
+};
+#endif
+
+/**
+ *  Values, these accept every type
+ */
+template <>
+class SignatureArgument<Value>
+{
+private:
+    /**
+     *  The converted value
+     *  @var Value
+     */
+    Value _value;
+
+public:
+    /**
+     *  Constructor
+     *  @param  params      The parameters
+     *  @param  index       Index of the parameter
+     */
+    SignatureArgument(const ParameterView &params, size_t index) : _value(params[index]) {}
+
+    /**
+     *  Type-hint for the argument
+     *  @return Type
+     */
+    static Type type() { return Type::Undefined; }
+
+    /**
+     *  Cast to the native type
+     *  @return Value
+     */
+    operator const Value & () const { return _value; }
+};
+
+/**
+ *  Class to find out how a return value is passed back to PHP: integral
+ *  and floating point values are widened to the type that PHP uses, other
+ *  values are passed as they are, or wrapped in a Php::Value
+ */
+template <typename T, typename Enable = void> struct SignatureResult { using type = Value; };
+template <> struct SignatureResult<bool> { using type = bool; };
+template <> struct SignatureResult<std::string> { using type = const std::string &; };
+template <typename T> struct SignatureResult<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> { using type = int64_t; };
+template <typename T> struct SignatureResult<T, typename std::enable_if<std::is_floating_point<T>::value>::type> { using type = double; };
+#if __cplusplus >= 201703L
+template <> struct SignatureResult<std::string_view> { using type = std::string_view; };
+#endif
+
+/**
+ *  Common base class for all signatures
+ */
+template <typename R, typename... Args>
+class SignatureBase
+{
+public:
+    /**
+     *  Number of arguments
+     */
+    static constexpr size_t size = sizeof...(Args);
+
+    /**
+     *  Name of an argument (the Zend engine requires each argument to have a
+     *  name, but this can not be derived from the signature)
+     *  @param  index       Index of the argument
+     *  @return const char *
+     */
+    static const char *name(size_t index)
+    {
+        // the names
+        static const char *names[] = { "arg1", "arg2", "arg3", "arg4", "arg5", "arg6", "arg7", "arg8", "arg9", "arg10", "arg11", "arg12" };
+
+        // look up the name
+        return index < sizeof(names) / sizeof(names[0]) ? names[index] : "arg";
+    }
+
+    /**
+     *  Type-hint of an argument
+     *  @param  index       Index of the argument
+     *  @return Type
+     */
+    static Type type(size_t index)
+    {
+        // the types (with an extra leading element, because arrays of size zero are not allowed)
+        static const Type types[] = { Type::Undefined, SignatureArgument<typename std::decay<Args>::type>::type()... };
+
+        // look up the type
+        return types[index + 1];
+    }
+
+protected:
+    /**
+     *  Invoke a callback, and pass the return value to PHP
+     *  @param  return_value    The return value
+     *  @param  callback        The callback to invoke
+     *  @param  params          The parameters
+     */
+    template <typename Callback, size_t... I>
+    static void call(struct _zval_struct *return_value, std::false_type, const Callback &callback, const ParameterView &params, SignatureIndices<I...>)
+    {
+        // invoke the callback, the temporary converters stay in scope during the call
+        ZendCallable::yield(return_value, static_cast<typename SignatureResult<typename std::decay<R>::type>::type>(callback(SignatureArgument<typename std::decay<Args>::type>(params, I)...)));
+    }
+
+    /**
+     *  Invoke a callback without a return value
+     *  @param  return_value    The return value
+     *  @param  callback        The callback to invoke
+     *  @param  params          The parameters
+     */
+    template <typename Callback, size_t... I>
+    static void call(struct _zval_struct *return_value, std::true_type, const Callback &callback, const ParameterView &params, SignatureIndices<I...>)
+    {
+        // invoke the callback, the temporary converters stay in scope during the call
+        callback(SignatureArgument<typename std::decay<Args>::type>(params, I)...);
+
+        // there is no return value, so we just return null
+        ZendCallable::yield(return_value, nullptr);
+    }
+
+    /**
+     *  Check the parameters and call a callback
+     *  @param  execute_data    Data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     *  @param  callback        The callback to invoke
+     */
+    template <typename Callback>
+    static void call(struct _zend_execute_data *execute_data, struct _zval_struct *return_value, const Callback &callback)
+    {
+        // check parameter count
+        if (!ZendCallable::valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ code
+        try
+        {
+            // unpack the parameters and make the call
+            call(return_value, typename std::is_void<R>::type(), callback, params, typename SignatureSequence<sizeof...(Args)>::type());
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            ZendCallable::handle(throwable);
+        }
+    }
+};
+
+/**
+ *  The signature class, this is only implemented for function pointers
+ *  and pointers to members
+ */
+template <typename F>
+class Signature;
+
+/**
+ *  Signature for regular functions and static methods
+ */
+template <typename R, typename... Args>
+class Signature<R(*)(Args...)> : public SignatureBase<R, Args...>
+{
+public:
+    /**
+     *  Flags that should be added when the callback is registered as method
+     *  @return int
+     */
+    static int flags() { return Static; }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    Data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <R(*callback)(Args...)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // call the function
+        Signature::call(execute_data, return_value, callback);
+    }
+};
+
+/**
+ *  Signature for methods
+ */
+template <typename T, typename R, typename... Args>
+class Signature<R(T::*)(Args...)> : public SignatureBase<R, Args...>
+{
+private:
+    /**
+     *  Helper class that binds the object to the method
+     */
+    template <R(T::*callback)(Args...)>
+    struct Bound
+    {
+        T *object;
+        template <typename... Params> R operator()(Params&&... params) const { return (object->*callback)(std::forward<Params>(params)...); }
+    };
+
+public:
+    /**
+     *  Flags that should be added when the callback is registered as method
+     *  @return int
+     */
+    static int flags() { return 0; }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    Data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <R(T::*callback)(Args...)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // cast the base to the correct object and invoke the member
+        Signature::call(execute_data, return_value, Bound<callback>{ static_cast<T*>(ZendCallable::instance(execute_data)) });
+    }
+};
+
+/**
+ *  Signature for const methods
+ */
+template <typename T, typename R, typename... Args>
+class Signature<R(T::*)(Args...) const> : public SignatureBase<R, Args...>
+{
+private:
+    /**
+     *  Helper class that binds the object to the method
+     */
+    template <R(T::*callback)(Args...) const>
+    struct Bound
+    {
+        const T *object;
+        template <typename... Params> R operator()(Params&&... params) const { return (object->*callback)(std::forward<Params>(params)...); }
+    };
+
+public:
+    /**
+     *  Flags that should be added when the callback is registered as method
+     *  @return int
+     */
+    static int flags() { return 0; }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    Data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <R(T::*callback)(Args...) const>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // cast the base to the correct object and invoke the member
+        Signature::call(execute_data, return_value, Bound<callback>{ static_cast<const T*>(ZendCallable::instance(execute_data)) });
+    }
+};
+
+/**
+ *  Trait to check whether a callback should be registered via its signature,
+ *  callbacks with one of the classic signatures (no arguments, or a single
+ *  Parameters or ParameterView argument) are registered the classic way
+ */
+template <typename F> struct SignatureTyped : std::false_type {};
+template <typename R, typename... Args> struct SignatureTyped<R(*)(Args...)> : std::true_type {};
+template <typename T, typename R, typename... Args> struct SignatureTyped<R(T::*)(Args...)> : SignatureTyped<R(*)(Args...)> {};
+template <typename T, typename R, typename... Args> struct SignatureTyped<R(T::*)(Args...) const> : SignatureTyped<R(*)(Args...)> {};
+template <> struct SignatureTyped<void(*)()> : std::false_type {};
+template <> struct SignatureTyped<Value(*)()> : std::false_type {};
+template <> struct SignatureTyped<void(*)(Parameters &)> : std::false_type {};
+template <> struct SignatureTyped<Value(*)(Parameters &)> : std::false_type {};
+template <> struct SignatureTyped<void(*)(ParameterView &)> : std::false_type {};
+template <> struct SignatureTyped<Value(*)(ParameterView &)> : std::false_type {};
+
+/**
+ *  End of namespace
+ */
+}
+
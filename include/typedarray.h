@@ -0,0 +1,555 @@
+/**
+ *  TypedArray.h
+ *
+ *  Ready-made class for arrays of numbers that are stored in contiguous
+ *  memory. A PHP array of doubles costs a zval plus the overhead of a hash
+ *  bucket per element, a Php::TypedArray<double> only needs eight bytes.
+ *
+ *  The class can be used from PHP like a regular array (with the [] operator,
+ *  count() and foreach), and it has a couple of bulk operations that run
+ *  over the contiguous storage: sum(), min(), max(), scale() and dot().
+ *
+ *      extension.add(Php::TypedArray<double>::define("DoubleArray"));
+ *      extension.add(Php::TypedArray<int32_t>::define("Int32Array"));
+ *
+ *  In PHP:
+ *
+ *      $array = new DoubleArray(1000);         // 1000 zero's
+ *      $array = new DoubleArray([1.0, 2.5]);   // copy of a PHP array
+ *      $array[] = 3.0;
+ *      echo($array->sum());
+ *
+ *  Supported element types are int8_t up to int64_t, float and double.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+template <typename T>
+class TypedArray : public TypedArrayBase
+{
+    static_assert(std::is_same<T, int8_t>::value || std::is_same<T, int16_t>::value || std::is_same<T, int32_t>::value || std::is_same<T, int64_t>::value ||
+                  std::is_same<T, float>::value || std::is_same<T, double>::value, "Php::TypedArray only supports int8_t, int16_t, int32_t, int64_t, float and double elements");
+
+private:
+    /**
+     *  Type that is used for sums and dot products
+     */
+    using Accumulator = typename std::conditional<std::is_floating_point<T>::value, double, int64_t>::type;
+
+    /**
+     *  Running total of floating point terms
+     */
+    struct FloatTotal
+    {
+        double sum = 0.0;
+
+        void add(double value) { sum += value; }
+        void add(double a, double b) { sum += a * b; }
+        void add(const FloatTotal &that) { sum += that.sum; }
+        Value value() const { return sum; }
+    };
+
+    /**
+     *  Running total of integer terms. The terms are added with wraparound
+     *  arithmetic, which gives the exact result as long as the terms can not
+     *  add up to more than fits in 64 bits. Beyond that the floating point
+     *  total is returned instead, just like php switches to floats when an
+     *  integer overflows.
+     */
+    struct IntegerTotal
+    {
+        uint64_t wrapped = 0;
+        double approximation = 0.0;
+        double magnitude = 0.0;
+
+        void add(int64_t value)
+        {
+            wrapped += (uint64_t)value;
+            approximation += (double)value;
+            magnitude += std::fabs((double)value);
+        }
+        void add(int64_t a, int64_t b)
+        {
+            double term = (double)a * (double)b;
+            wrapped += (uint64_t)a * (uint64_t)b;
+            approximation += term;
+            magnitude += std::fabs(term);
+        }
+        void add(const IntegerTotal &that)
+        {
+            wrapped += that.wrapped;
+            approximation += that.approximation;
+            magnitude += that.magnitude;
+        }
+        Value value() const
+        {
+            // the threshold leaves room for rounding errors in the magnitude
+            if (magnitude >= 9.2e18) return approximation;
+
+            // convert to a signed number without relying on implementation defined casts
+            if (wrapped <= (uint64_t)std::numeric_limits<int64_t>::max()) return (int64_t)wrapped;
+            return -(int64_t)(~wrapped) - 1;
+        }
+    };
+
+    /**
+     *  Type that is used for the running totals
+     */
+    using Total = typename std::conditional<std::is_floating_point<T>::value, FloatTotal, IntegerTotal>::type;
+
+    /**
+     *  The elements
+     *  @var std::vector
+     */
+    std::vector<T> _data;
+
+    /**
+     *  Helper function to wrap a single number into a Value
+     *  @param  value
+     *  @return Value
+     */
+    static Value wrap(T value)
+    {
+        if (std::is_floating_point<T>::value) return (double)value;
+        return (int64_t)value;
+    }
+
+    /**
+     *  Helper function to convert a Value (or a borrowed ValueView) into an element
+     *  @param  value
+     *  @return T
+     */
+    template <typename V>
+    static T unwrap(const V &value)
+    {
+        if (std::is_floating_point<T>::value || value.isFloat()) return saturate<T>(value.floatValue());
+        return saturate<T>(value.numericValue());
+    }
+
+    /**
+     *  Helper function to convert an element of a typed array of any type
+     *  @param  array
+     *  @param  index
+     *  @return T
+     */
+    static T unwrap(const TypedArrayBase *array, size_t index)
+    {
+        if (array->floating()) return saturate<T>(array->floatAt(index));
+        return saturate<T>(array->integerAt(index));
+    }
+
+    /**
+     *  Helper function to convert a key into an offset, only integers and
+     *  strings that hold an integer (like "12") are accepted
+     *  @param  key
+     *  @return int64_t
+     */
+    static int64_t offset(const Value &key)
+    {
+        // integers are used as they are
+        if (key.isNumeric()) return key.numericValue();
+
+        // strings must hold an integer in its canonical form
+        if (key.isString())
+        {
+            std::string text = key.stringValue();
+            try
+            {
+                size_t used;
+                long long number = std::stoll(text, &used);
+                if (used == text.size() && std::to_string(number) == text) return number;
+            }
+            catch (const std::exception &exception)
+            {
+                // not a number, or a number that does not fit
+            }
+        }
+
+        // floats, null and other types would silently address a different element
+        throw Error("Illegal offset type");
+    }
+
+    /**
+     *  Helper function to check an index
+     *  @param  key
+     *  @return size_t
+     */
+    size_t index(const Value &key) const
+    {
+        // get the index
+        int64_t result = offset(key);
+
+        // check the range
+        if (result < 0 || (size_t)result >= _data.size()) throw Error("Offset " + std::to_string(result) + " is out of range");
+
+        // done
+        return (size_t)result;
+    }
+
+    /**
+     *  Iterator class that is used when a typed array is used in foreach
+     */
+    class TypedIterator : public Iterator
+    {
+    private:
+        /**
+         *  The array and the position
+         */
+        TypedArray<T> *_array;
+        size_t _position = 0;
+
+    public:
+        /**
+         *  Constructor
+         *  @param  array
+         */
+        TypedIterator(TypedArray<T> *array) : Iterator(array), _array(array) {}
+
+        /**
+         *  Implementation of the iterator methods
+         */
+        virtual bool valid() override { return _position < _array->_data.size(); }
+        virtual Value current() override { return wrap(_array->_data[_position]); }
+        virtual Value key() override { return (int64_t)_position; }
+        virtual void next() override { _position += 1; }
+        virtual void rewind() override { _position = 0; }
+    };
+
+public:
+    /**
+     *  Constructor
+     *  @param  size        Initial number of elements (all zero)
+     */
+    TypedArray(size_t size = 0) : _data(size) {}
+
+    /**
+     *  Constructor that copies elements
+     *  @param  data
+     *  @param  size
+     */
+    TypedArray(const T *data, size_t size) : _data(data, data + size) {}
+
+    /**
+     *  Destructor
+     */
+    virtual ~TypedArray() = default;
+
+    /**
+     *  The PHP constructor, it takes an optional number of elements or a
+     *  PHP array or other typed array to copy
+     *  @param  params
+     */
+    void __construct(ParameterView &params)
+    {
+        // nothing to initialize if there are no parameters
+        if (params.empty()) return;
+
+        // the parameter
+        Value input = params[0];
+
+        // a number holds the initial size
+        if (input.isNumeric())
+        {
+            // the size can not be negative
+            if (input.numericValue() < 0) throw Error("Size can not be negative");
+
+            // resize the storage
+            _data.resize((size_t)input.numericValue());
+        }
+        else if (input.isArray())
+        {
+            // copy the elements in array order
+            _data.clear();
+            _data.reserve(input.size());
+            for (const auto &entry : input.items()) _data.push_back(unwrap(entry.value));
+        }
+        else if (auto *other = dynamic_cast<TypedArrayBase*>(input.implementation()))
+        {
+            // copy the elements one by one (the other array may have a different type)
+            _data.resize(other->size());
+            for (size_t i = 0; i < _data.size(); ++i) _data[i] = unwrap(other, i);
+        }
+        else throw Error("Expecting a size, an array or a typed array");
+    }
+
+    /**
+     *  Direct access to the elements from C++
+     *  @return T*
+     */
+    T *data() { return _data.data(); }
+    const T *data() const { return _data.data(); }
+
+    /**
+     *  Access to the storage from C++
+     *  @return std::vector
+     */
+    std::vector<T> &vector() { return _data; }
+    const std::vector<T> &vector() const { return _data; }
+
+    /**
+     *  Implementation of the TypedArrayBase methods
+     */
+    virtual size_t size() const override { return _data.size(); }
+    virtual bool floating() const override { return std::is_floating_point<T>::value; }
+    virtual int64_t integerAt(size_t index) const override { return saturate<int64_t>((Accumulator)_data[index]); }
+    virtual double floatAt(size_t index) const override { return (double)_data[index]; }
+    virtual void assign(size_t index, int64_t value) override { _data[index] = saturate<T>(value); }
+    virtual void assign(size_t index, double value) override { _data[index] = saturate<T>(value); }
+    virtual void append(int64_t value) override { _data.push_back(saturate<T>(value)); }
+    virtual void append(double value) override { _data.push_back(saturate<T>(value)); }
+
+    /**
+     *  Implementation of the ArrayAccess methods (these are only used when
+     *  the methods are called by name, the [] operator does not use them)
+     *  @param  key
+     *  @param  value
+     */
+    virtual bool offsetExists(const Value &key) override
+    {
+        int64_t result = offset(key);
+        return result >= 0 && (size_t)result < _data.size();
+    }
+    virtual void offsetSet(const Value &key, const Value &value) override
+    {
+        if (key.isNull()) _data.push_back(unwrap(value));
+        else _data[index(key)] = unwrap(value);
+    }
+    virtual Value offsetGet(const Value &key) override
+    {
+        return wrap(_data[index(key)]);
+    }
+    virtual void offsetUnset(const Value &key) override
+    {
+        throw Error("Elements can not be removed from a typed array");
+    }
+
+    /**
+     *  Implementation of the Countable method
+     *  @return long
+     */
+    virtual long count() override { return (long)_data.size(); }
+
+    /**
+     *  Implementation of the Traversable method
+     *  @return Iterator
+     */
+    virtual Iterator *getIterator() override { return new TypedIterator(this); }
+
+    /**
+     *  Sum of all elements (the partial sums are independent of each other,
+     *  so that the compiler can vectorize the loop). An integer sum that does
+     *  not fit in 64 bits is returned as a float.
+     *  @return Value
+     */
+    Value sum() const
+    {
+        // partial sums
+        Total partial[4];
+
+        // number of elements, and the number that can be processed in blocks
+        size_t size = _data.size(), blocks = size & ~(size_t)3;
+
+        // process blocks of four elements
+        for (size_t i = 0; i < blocks; i += 4)
+        {
+            partial[0].add((Accumulator)_data[i]);
+            partial[1].add((Accumulator)_data[i + 1]);
+            partial[2].add((Accumulator)_data[i + 2]);
+            partial[3].add((Accumulator)_data[i + 3]);
+        }
+
+        // process the remaining elements
+        for (size_t i = blocks; i < size; ++i) partial[0].add((Accumulator)_data[i]);
+
+        // combine the partial sums
+        partial[0].add(partial[1]);
+        partial[2].add(partial[3]);
+        partial[0].add(partial[2]);
+
+        // done
+        return partial[0].value();
+    }
+
+    /**
+     *  Smallest element (null for an empty array)
+     *  @return Value
+     */
+    Value min() const
+    {
+        // empty arrays have no minimum
+        if (_data.empty()) return nullptr;
+
+        // find the minimum (this is written without branches to allow vectorization)
+        T result = _data[0];
+        for (auto value : _data) result = value < result ? value : result;
+
+        // done
+        return wrap(result);
+    }
+
+    /**
+     *  Largest element (null for an empty array)
+     *  @return Value
+     */
+    Value max() const
+    {
+        // empty arrays have no maximum
+        if (_data.empty()) return nullptr;
+
+        // find the maximum (this is written without branches to allow vectorization)
+        T result = _data[0];
+        for (auto value : _data) result = value > result ? value : result;
+
+        // done
+        return wrap(result);
+    }
+
+    /**
+     *  Multiply all elements with a factor
+     *  @param  params
+     */
+    void scale(ParameterView &params)
+    {
+        // floating point numbers are multiplied with a floating point factor
+        if (std::is_floating_point<T>::value)
+        {
+            T factor = saturate<T>(params.floatValue(0));
+            for (auto &value : _data) value *= factor;
+        }
+        else
+        {
+            int64_t factor = params.numericValue(0);
+            for (auto &value : _data)
+            {
+                // products that do not fit in 64 bits are saturated via a float
+                double product = (double)value * (double)factor;
+                value = std::fabs(product) < 9.2e18 ? saturate<T>((int64_t)value * factor) : saturate<T>(product);
+            }
+        }
+    }
+
+    /**
+     *  Dot product with a typed array or a PHP array of the same size
+     *  @param  params
+     *  @return Value
+     */
+    Value dot(ParameterView &params) const
+    {
+        // the other operand
+        Value input = params[0];
+
+        // the other operand as a typed array
+        auto *other = dynamic_cast<TypedArrayBase*>(input.implementation());
+
+        // the sizes must be the same
+        size_t size = other ? other->size() : input.isArray() ? (size_t)input.size() : (size_t)-1;
+        if (size != _data.size()) throw Error("Expecting a typed array or an array with " + std::to_string(_data.size()) + " elements");
+
+        // an array of the same type can be processed right away
+        if (auto *same = dynamic_cast<TypedArray<T>*>(other)) return multiply(same->_data.data());
+
+        // other arrays are copied into a buffer of the same type first
+        std::vector<T> buffer(size);
+        if (other) for (size_t i = 0; i < size; ++i) buffer[i] = unwrap(other, i);
+        else
+        {
+            size_t i = 0;
+            for (const auto &entry : input.items()) buffer[i++] = unwrap(entry.value);
+        }
+
+        // calculate the product
+        return multiply(buffer.data());
+    }
+
+    /**
+     *  Dot product with a buffer that holds (at least) the same number of
+     *  elements. An integer product that does not fit in 64 bits is returned
+     *  as a float.
+     *  @param  that
+     *  @return Value
+     */
+    Value multiply(const T *that) const
+    {
+        // partial sums
+        Total partial[4];
+
+        // number of elements, and the number that can be processed in blocks
+        size_t size = _data.size(), blocks = size & ~(size_t)3;
+
+        // process blocks of four elements
+        for (size_t i = 0; i < blocks; i += 4)
+        {
+            partial[0].add((Accumulator)_data[i], (Accumulator)that[i]);
+            partial[1].add((Accumulator)_data[i + 1], (Accumulator)that[i + 1]);
+            partial[2].add((Accumulator)_data[i + 2], (Accumulator)that[i + 2]);
+            partial[3].add((Accumulator)_data[i + 3], (Accumulator)that[i + 3]);
+        }
+
+        // process the remaining elements
+        for (size_t i = blocks; i < size; ++i) partial[0].add((Accumulator)_data[i], (Accumulator)that[i]);
+
+        // combine the partial sums
+        partial[0].add(partial[1]);
+        partial[2].add(partial[3]);
+        partial[0].add(partial[2]);
+
+        // done
+        return partial[0].value();
+    }
+
+    /**
+     *  Convert to a regular PHP array
+     *  @return Value
+     */
+    Value toArray() const
+    {
+        // convert to the type of a PHP number first
+        std::vector<Accumulator> buffer(_data.begin(), _data.end());
+
+        // create the array
+        return Value::fromSpan(buffer.data(), buffer.size());
+    }
+
+    /**
+     *  Create the class description, with all methods registered, that can
+     *  be added to an extension or a namespace
+     *  @param  name        Name of the class in PHP
+     *  @param  flags       Class flags
+     *  @return Class
+     */
+    static Class<TypedArray<T>> define(const char *name, int flags = 0)
+    {
+        // the class description
+        Class<TypedArray<T>> result(name, flags);
+
+        // the methods that are available from PHP
+        result.template method<&TypedArray<T>::__construct>("__construct");
+        result.template method<&TypedArray<T>::sum>("sum");
+        result.template method<&TypedArray<T>::min>("min");
+        result.template method<&TypedArray<T>::max>("max");
+        result.template method<&TypedArray<T>::scale>("scale", { ByVal("factor") });
+        result.template method<&TypedArray<T>::dot>("dot", { ByVal("that") });
+        result.template method<&TypedArray<T>::toArray>("toArray");
+
+        // done
+        return result;
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,114 @@
+/**
+ *  TypedArrayBase.h
+ *
+ *  Base class of all Php::TypedArray<T> classes. The library installs
+ *  special object handlers for classes that are derived from this base:
+ *  reading and writing elements with the [] operator, isset() and count()
+ *  are then handled directly by these handlers, without converting the
+ *  offsets and values into Php::Value objects and without going through
+ *  the ArrayAccess and Countable methods.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class PHPCPP_EXPORT TypedArrayBase : public Base, public ArrayAccess, public Countable, public Traversable
+{
+public:
+    /**
+     *  Destructor
+     */
+    virtual ~TypedArrayBase() = default;
+
+    /**
+     *  Number of elements
+     *  @return size_t
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     *  Are the elements floating point numbers?
+     *  @return bool
+     */
+    virtual bool floating() const = 0;
+
+    /**
+     *  Read an element, converted to an integer or a floating point number
+     *  (the index must be in range)
+     *  @param  index
+     *  @return int64_t|double
+     */
+    virtual int64_t integerAt(size_t index) const = 0;
+    virtual double floatAt(size_t index) const = 0;
+
+    /**
+     *  Store an element (the index must be in range)
+     *  @param  index
+     *  @param  value
+     */
+    virtual void assign(size_t index, int64_t value) = 0;
+    virtual void assign(size_t index, double value) = 0;
+
+    /**
+     *  Add an element to the end
+     *  @param  value
+     */
+    virtual void append(int64_t value) = 0;
+    virtual void append(double value) = 0;
+
+protected:
+    /**
+     *  Convert a number to an element type. A plain cast is undefined for
+     *  numbers that do not fit, so these are saturated instead: integers get
+     *  the lowest or highest value of the type, NaN becomes zero, and floats
+     *  that are too big become infinite.
+     *  @param  value
+     *  @return T
+     */
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, T>::type saturate(double value)
+    {
+        if (value > std::numeric_limits<T>::max()) return std::numeric_limits<T>::infinity();
+        if (value < std::numeric_limits<T>::lowest()) return -std::numeric_limits<T>::infinity();
+        return (T)value;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value, T>::type saturate(double value)
+    {
+        if (std::isnan(value)) return 0;
+        if (value <= (double)std::numeric_limits<T>::lowest()) return std::numeric_limits<T>::lowest();
+        if (value >= (double)std::numeric_limits<T>::max()) return std::numeric_limits<T>::max();
+        return (T)value;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, T>::type saturate(int64_t value)
+    {
+        return (T)value;
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value, T>::type saturate(int64_t value)
+    {
+        if (value < 0) return value < (int64_t)std::numeric_limits<T>::lowest() ? std::numeric_limits<T>::lowest() : (T)value;
+        return (uint64_t)value > (uint64_t)std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : (T)value;
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -33,6 +33,7 @@ namespace Php {
  */
 class Base;
 class ValueIterator;
+class HashView;
 class Parameters;
 template <class Type> class HashMember;
 
@@ -75,13 +76,10 @@ public:
      *  @param  value
      */
     template <typename T>
-    Value(const std::vector<T> &input) : Value(Type::Array)
+    Value(const std::vector<T> &input) : Value()
     {
-        // index
-        int i = 0;
-
-        // set all elements
-        for (auto &elem : input) setRaw(i++, elem);
+        // fill the array
+        assign(input);
     }
 
     // old visual c++ environments have no support for initializer lists
@@ -183,6 +181,7 @@ public:
     Value &operator=(double value);
     Value &operator=(const HashMember<std::string> &value);
     Value &operator=(const HashMember<int> &value);
+    Value &operator=(const HashMember<Key> &value);
 
     /**
      *  Add a value to the object
@@ -472,6 +471,20 @@ public:
      */
     std::string stringValue() const;
 
+#if __cplusplus >= 201703L
+    /**
+     *  Retrieve a view on the buffer of a string, without copying it. This
+     *  only works for string variables, other variables return an empty
+     *  view. The view is valid until the value is modified or destructed.
+     *  @return std::string_view
+     */
+    std::string_view stringView() const
+    {
+        const char *data = rawValue();
+        return data ? std::string_view(data, size()) : std::string_view();
+    }
+#endif
+
     /**
      *  Retrieve the value as decimal
      *  @return double
@@ -499,6 +512,19 @@ public:
         size_t count = size();
         result.reserve(count);
 
+        // the elements of the array
+        HashView view = items();
+
+        // a list can be read straight from the hash table
+        if (view.isList())
+        {
+            // copy all elements
+            for (const auto &entry : view) result.push_back(convert(entry.value, (T *)nullptr));
+
+            // done
+            return result;
+        }
+
         // and fill the result vector
         for (size_t i = 0; i<count; i++)
         {
@@ -513,6 +539,42 @@ public:
         return result;
     }
 
+    /**
+     *  Copy the elements of an array of numbers into a buffer. The elements
+     *  are copied in the order of the array, until the buffer is full. For
+     *  lists that only hold numbers of the requested type, the values are
+     *  read straight from the hash table without any conversions, other
+     *  elements are converted with the regular PHP rules. For all types
+     *  other than arrays nothing is copied.
+     *
+     *  @param  buffer      The buffer to fill
+     *  @param  size        Number of elements that fit in the buffer
+     *  @return size_t      Number of elements that were copied
+     */
+    size_t copyTo(int64_t *buffer, size_t size) const;
+    size_t copyTo(double *buffer, size_t size) const;
+
+    /**
+     *  Create an array (a list) holding all numbers from a buffer
+     *  @param  data        The numbers
+     *  @param  size        Number of elements
+     *  @return Value
+     */
+    static Value fromSpan(const int64_t *data, size_t size);
+    static Value fromSpan(const double *data, size_t size);
+
+#if __cplusplus >= 202002L
+    /**
+     *  Overloads for std::span
+     *  @param  buffer
+     *  @return size_t|Value
+     */
+    size_t copyTo(std::span<int64_t> buffer) const { return copyTo(buffer.data(), buffer.size()); }
+    size_t copyTo(std::span<double> buffer) const { return copyTo(buffer.data(), buffer.size()); }
+    static Value fromSpan(std::span<const int64_t> data) { return fromSpan(data.data(), data.size()); }
+    static Value fromSpan(std::span<const double> data) { return fromSpan(data.data(), data.size()); }
+#endif
+
     /**
      *  Convert the object to a set
      *
@@ -533,6 +595,19 @@ public:
         // how many elements are we inserting
         size_t count = size();
 
+        // the elements of the array
+        HashView view = items();
+
+        // a list can be read straight from the hash table
+        if (view.isList())
+        {
+            // copy all elements
+            for (const auto &entry : view) result.insert(convert(entry.value, (T *)nullptr));
+
+            // done
+            return result;
+        }
+
         // and fill the result set
         for (size_t i = 0; i<count; i++)
         {
@@ -600,6 +675,14 @@ public:
      */
     iterator end() const;
 
+    /**
+     *  Return a non-owning view on the elements of an array. Iterating over
+     *  the view does not allocate memory and does not copy the keys and
+     *  values. For all other types an empty view is returned.
+     *  @return HashView
+     */
+    HashView items() const;
+
     /**
      *  The number of members in case of an array or object
      *  @return int
@@ -660,6 +743,13 @@ public:
         return contains(key, ::strlen(key));
     }
 
+    /**
+     *  Is a certain key with a precalculated hash set in the array
+     *  @param  key
+     *  @return bool
+     */
+    virtual bool contains(const Key &key) const override;
+
     /**
      *  Is a certain key set in the array, when that key is stored as value object
      *  @param  key
@@ -803,6 +893,13 @@ public:
         return get(key.c_str(), key.size());
     }
 
+    /**
+     *  Get access to a member by a key with a precalculated hash
+     *  @param  key
+     *  @return Value
+     */
+    virtual Value get(const Key &key) const override;
+
     /**
      *  Get access to a certain variant member
      *  @param  key
@@ -855,6 +952,13 @@ public:
         return set(key.c_str(), key.size(), value);
     }
 
+    /**
+     *  Overwrite the value at a key with a precalculated hash
+     *  @param  key
+     *  @param  value
+     */
+    virtual void set(const Key &key, const Value &value) override;
+
     /**
      *  Overwrite the value at a certain variant index
      *  @param  key
@@ -867,6 +971,81 @@ public:
         return set(key.stringValue(), value);
     }
 
+    /**
+     *  Set a certain property by moving a value into the array: the array
+     *  takes over the reference of the value, which is left undefined
+     *  (objects get a copy, like with the other set() methods)
+     *  @param  index       Index of the property to set
+     *  @param  value       Value to move
+     */
+    void set(int index, Value &&value);
+
+    /**
+     *  Set a certain property by moving a value into the array
+     *  @param  key         Key of the property to set
+     *  @param  size        Size of the key
+     *  @param  value       Value to move
+     */
+    void set(const char *key, int size, Value &&value);
+
+    /**
+     *  Set a certain property by moving a value into the array
+     *  @param  key         Key to set
+     *  @param  value       Value to move
+     */
+    void set(const char *key, Value &&value)
+    {
+        set(key, ::strlen(key), std::move(value));
+    }
+
+    /**
+     *  Set a certain property by moving a value into the array
+     *  @param  key         Key to set
+     *  @param  value       Value to move
+     */
+    void set(const std::string &key, Value &&value)
+    {
+        set(key.c_str(), key.size(), std::move(value));
+    }
+
+    /**
+     *  Set a certain property at a variant index by moving a value into the array
+     *  @param  key         Key to set
+     *  @param  value       Value to move
+     */
+    void set(const Value &key, Value &&value)
+    {
+        if (key.isNumeric()) return set(key.numericValue(), std::move(value));
+        if (key.isString()) return set(key.rawValue(), key.size(), std::move(value));
+        return set(key.stringValue(), std::move(value));
+    }
+
+    /**
+     *  Add an element to the end of the array, like $array[] = $value does
+     *  in PHP. Calling this method will turn the value into an array, unless
+     *  it is an object that implements ArrayAccess.
+     *  @param  value       Value to add (an rvalue is moved into the array)
+     *  @throws Error       For objects without ArrayAccess, or when the next
+     *                      index is already occupied
+     */
+    void push_back(const Value &value);
+    void push_back(Value &&value);
+
+    /**
+     *  Construct a new element from the arguments and add it to the end of
+     *  the array, or store it under an index or key. The element is built
+     *  once and then moved into the array, without refcount changes.
+     *  @param  args        Arguments for the Value constructor
+     */
+    template <typename... Args>
+    void emplace_back(Args&&... args) { push_back(Value(std::forward<Args>(args)...)); }
+
+    template <typename... Args>
+    void emplace(int index, Args&&... args) { set(index, Value(std::forward<Args>(args)...)); }
+
+    template <typename... Args>
+    void emplace(const std::string &key, Args&&... args) { set(key, Value(std::forward<Args>(args)...)); }
+
     /**
      *  Unset a member by its index
      *  @param  index
@@ -899,6 +1078,12 @@ public:
         return unset(key.c_str(), key.size());
     }
 
+    /**
+     *  Unset a member by a key with a precalculated hash
+     *  @param  key
+     */
+    virtual void unset(const Key &key) override;
+
     /**
      *  Unset a member by its key
      *  @param  key
@@ -967,6 +1152,23 @@ public:
         return get(key);
     }
 
+    /**
+     *  Array access operator with a key that has a precalculated hash
+     *  @param  key
+     *  @return HashMember
+     */
+    HashMember<Key> operator[](const Key &key);
+
+    /**
+     *  Array access operator with a key that has a precalculated hash
+     *  @param  key
+     *  @return Value
+     */
+    Value operator[](const Key &key) const
+    {
+        return get(key);
+    }
+
     /**
      *  Index by other value object
      *  @param  key
@@ -1159,6 +1361,13 @@ private:
      */
     Value& operator=(struct _zval_struct* value);
 
+    /**
+     *  Retrieve the array for writing elements in place (this turns the
+     *  value into an array, and separates it from other copies)
+     *  @return struct _zval_struct
+     */
+    virtual struct _zval_struct *writable() override;
+
 protected:
     /**
      *  The wrapped zval
@@ -1205,6 +1414,60 @@ protected:
      */
     void setRaw(const char *key, int size, const Value &value);
 
+    /**
+     *  Turn the (null) value into an empty packed array with room for a
+     *  number of elements
+     *  @param  size        Number of elements
+     *  @return bool        Was packed storage allocated (false for empty arrays)
+     */
+    bool initPacked(size_t size);
+
+    /**
+     *  Fill the (null) value with the numbers in a buffer
+     *  @param  data
+     *  @param  size
+     */
+    void assign(const int64_t *data, size_t size);
+    void assign(const double *data, size_t size);
+
+    /**
+     *  Fill the (null) value with the elements of a vector. For the most
+     *  common element types the zvals are written straight into a presized
+     *  packed hash table, other types are added one at a time.
+     *  @param  input
+     */
+    void assign(const std::vector<int64_t> &input) { assign(input.data(), input.size()); }
+    void assign(const std::vector<double> &input) { assign(input.data(), input.size()); }
+    void assign(const std::vector<bool> &input);
+    void assign(const std::vector<std::string> &input);
+
+    template <typename T>
+    void assign(const std::vector<T> &input)
+    {
+        // create the array
+        initPacked(input.size());
+
+        // index
+        int i = 0;
+
+        // set all elements
+        for (auto &elem : input) setRaw(i++, elem);
+    }
+
+    /**
+     *  Convert a borrowed element to the type of a vector or set element. The
+     *  pointer parameter is only used for selecting the right overload.
+     *  @param  view
+     *  @return T
+     */
+    static int64_t convert(const ValueView &view, int64_t *) { return view.numericValue(); }
+    static double convert(const ValueView &view, double *) { return view.floatValue(); }
+    static bool convert(const ValueView &view, bool *) { return view.boolValue(); }
+    static std::string convert(const ValueView &view, std::string *) { return view.stringValue(); }
+
+    template <typename T>
+    static T convert(const ValueView &view, T *) { return view.value(); }
+
     /**
      *  Internal helper method to create an `
      *  @param  begin       Should the iterator start at the begin?
@@ -1234,10 +1497,15 @@ protected:
     friend class IteratorImpl;
     friend class Extension;
     friend class HashIterator;
+    friend class ValueView;
     friend class TraverseIterator;
     friend class HashMember<int>;
     friend class HashMember<std::string>;
+    friend class HashMember<Key>;
+    friend class HashParent;
+    friend class ArrayBuilder;
     friend class Callable;
+    friend class CallableHandle;
     friend class ZendCallable;
     friend class Script;
     friend class ConstantImpl;
@@ -1249,6 +1517,16 @@ protected:
      */
     friend Value set_exception_handler(const std::function<Value(Parameters &params)> &handler);
     friend Value set_error_handler(const std::function<Value(Parameters &params)> &handler, Message message);
+    friend Value count(const Value &value);
+    friend Value strlen(const Value &value);
+    friend Value array_keys(const Value &value);
+    friend Value array_values(const Value &value);
+    friend Value array_push(Value &array, const Value &value);
+    friend Value array_merge(const Value &array1, const Value &array2);
+    friend Value array_slice(const Value &array, int64_t offset, const Value &length, bool preserve_keys);
+    friend Value array_search(const Value &needle, const Value &haystack, bool strict);
+    friend Value in_array(const Value &needle, const Value &haystack, bool strict);
+    friend Value implode(const char *glue, size_t size, const Value &pieces);
 };
 
 /**
@@ -13,6 +13,13 @@
  */
 #pragma once
 
+/**
+ *  Dependencies
+ */
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
 /**
  *  Forward declarations
  */
@@ -71,6 +78,21 @@ private:
      */
     static void yield(struct _zval_struct *return_value, std::nullptr_t value);
     static void yield(struct _zval_struct *return_value, const Php::Value &value);
+    static void yield(struct _zval_struct *return_value, bool value);
+    static void yield(struct _zval_struct *return_value, int64_t value);
+    static void yield(struct _zval_struct *return_value, double value);
+    static void yield(struct _zval_struct *return_value, const std::string &value);
+    static void yield(struct _zval_struct *return_value, const char *buffer, size_t size);
+#if __cplusplus >= 201703L
+    static void yield(struct _zval_struct *return_value, std::string_view value) { yield(return_value, value.data(), value.size()); }
+#endif
+
+    /**
+     *  The signature classes use the helper methods too
+     */
+    template <typename R, typename... Args> friend class SignatureBase;
+    template <typename F> friend class Signature;
+
 public:
     /**
      *  Execute the callback
@@ -296,6 +318,130 @@ public:
         }
     }
 
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <typename T, void (T::*callback)(ParameterView &parameters)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // cast the base to the correct object and invoke the member
+            (static_cast<T*>(instance(execute_data))->*callback)(params);
+
+            // there is no return value, so we just return null
+            yield(return_value, nullptr);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <typename T, void (T::*callback)(ParameterView &parameters) const>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // cast the base to the correct object and invoke the member
+            (static_cast<T*>(instance(execute_data))->*callback)(params);
+
+            // there is no return value, so we just return null
+            yield(return_value, nullptr);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <typename T, Value (T::*callback)(ParameterView &parameters)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // cast the base to the correct object and invoke the member
+            auto result = (static_cast<T*>(instance(execute_data))->*callback)(params);
+
+            // store the return value in the return_value
+            yield(return_value, result);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <typename T, Value (T::*callback)(ParameterView &parameters) const>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // cast the base to the correct object and invoke the member
+            auto result = (static_cast<T*>(instance(execute_data))->*callback)(params);
+
+            // store the return value in the return_value
+            yield(return_value, result);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
+
     /**
      *  Execute the callback
      *
@@ -407,6 +553,68 @@ public:
             handle(throwable);
         }
     }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <void(*callback)(ParameterView &parameters)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // execute the callback
+            callback(params);
+
+            // there is no return value, so we just return null
+            yield(return_value, nullptr);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
+
+    /**
+     *  Execute the callback
+     *
+     *  @param  execute_data    data about the PHP call stack
+     *  @param  return_value    The value we are returning to PHP
+     */
+    template <Value(*callback)(ParameterView &parameters)>
+    static void invoke(struct _zend_execute_data *execute_data, struct _zval_struct *return_value)
+    {
+        // check parameter count
+        if (!valid(execute_data, return_value)) return;
+
+        // wrap the parameters, this does not copy them
+        ParameterView params(execute_data);
+
+        // catch exceptions thrown by the C++ methods
+        try
+        {
+            // execute the callback
+            auto result = callback(params);
+
+            // store the return value in the return_value
+            yield(return_value, result);
+        }
+        catch (Throwable &throwable)
+        {
+            // handle the exception
+            handle(throwable);
+        }
+    }
 };
 
 /**
@@ -23,6 +23,22 @@
 #include <map>
 #include <set>
 #include <functional>
+#include <limits>
+#include <cmath>
+
+/**
+ *  Span is only available since C++20
+ */
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+/**
+ *  String views are only available since C++17
+ */
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 /**
  *  Include all headers files that are related to this library
@@ -41,10 +57,13 @@
 #include <phpcpp/streams.h>
 #include <phpcpp/message.h>
 #include <phpcpp/type.h>
+#include <phpcpp/key.h>
 #include <phpcpp/hashparent.h>
+#include <phpcpp/hashview.h>
 #include <phpcpp/value.h>
 #include <phpcpp/valueiterator.h>
 #include <phpcpp/array.h>
+#include <phpcpp/arraybuilder.h>
 #include <phpcpp/object.h>
 #include <phpcpp/globals.h>
 #include <phpcpp/argument.h>
@@ -54,6 +73,7 @@
 #include <phpcpp/hashmember.h>
 #include <phpcpp/super.h>
 #include <phpcpp/parameters.h>
+#include <phpcpp/parameterview.h>
 #include <phpcpp/modifiers.h>
 #include <phpcpp/base.h>
 #include <phpcpp/countable.h>
@@ -61,15 +81,20 @@
 #include <phpcpp/iterator.h>
 #include <phpcpp/traversable.h>
 #include <phpcpp/serializable.h>
+#include <phpcpp/typedarraybase.h>
 #include <phpcpp/classtype.h>
+#include <phpcpp/poolstatistics.h>
 #include <phpcpp/classbase.h>
 #include <phpcpp/constant.h>
 #include <phpcpp/interface.h>
 #include <phpcpp/zendcallable.h>
+#include <phpcpp/signature.h>
 #include <phpcpp/class.h>
+#include <phpcpp/typedarray.h>
 #include <phpcpp/namespace.h>
 #include <phpcpp/extension.h>
 #include <phpcpp/call.h>
+#include <phpcpp/callablehandle.h>
 #include <phpcpp/script.h>
 #include <phpcpp/file.h>
 #include <phpcpp/function.h>
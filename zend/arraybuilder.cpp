@@ -0,0 +1,157 @@
+/**
+ *  ArrayBuilder.cpp
+ *
+ *  Implementation of the helper class for building presized arrays
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  size
+ */
+ArrayBuilder::ArrayBuilder(size_t size)
+{
+    // create the array with packed storage of the right size
+    _array.initPacked(size);
+}
+
+/**
+ *  Add an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(const Value &value)
+{
+    // add the element, this fails when the highest possible index is already in use
+    if (!zend_hash_next_index_insert(Z_ARRVAL_P(_array._val), value._val)) throw Error("Cannot add element to the array as the next element is already occupied");
+
+    // the variable has one more reference (the array entry)
+    Z_TRY_ADDREF_P(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Move an element to the end of the array
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::append(Value &&value)
+{
+    // add the element, this fails when the highest possible index is already in use
+    if (!zend_hash_next_index_insert(Z_ARRVAL_P(_array._val), value._val)) throw Error("Cannot add element to the array as the next element is already occupied");
+
+    // the array took over the reference of the value
+    ZVAL_UNDEF(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Set an element with a numeric key
+ *  @param  index
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(int64_t index, const Value &value)
+{
+    // the variable has one more reference (the array entry)
+    Z_TRY_ADDREF_P(value._val);
+
+    // add the element (this will decrement refcount on any current variable)
+    zend_hash_index_update(Z_ARRVAL_P(_array._val), index, value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Move an element to a numeric key
+ *  @param  index
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(int64_t index, Value &&value)
+{
+    // the array takes over the reference of the value
+    zend_hash_index_update(Z_ARRVAL_P(_array._val), index, value._val);
+    ZVAL_UNDEF(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Set an element with a string key
+ *  @param  key
+ *  @param  size
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(const char *key, size_t size, const Value &value)
+{
+    // the variable has one more reference (the array entry)
+    Z_TRY_ADDREF_P(value._val);
+
+    // add the element (this will decrement refcount on any current variable)
+    zend_symtable_str_update(Z_ARRVAL_P(_array._val), key, size, value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Move an element to a string key
+ *  @param  key
+ *  @param  size
+ *  @param  value
+ *  @return ArrayBuilder
+ */
+ArrayBuilder &ArrayBuilder::set(const char *key, size_t size, Value &&value)
+{
+    // the array takes over the reference of the value
+    zend_symtable_str_update(Z_ARRVAL_P(_array._val), key, size, value._val);
+    ZVAL_UNDEF(value._val);
+
+    // allow chaining
+    return *this;
+}
+
+/**
+ *  Number of elements that have been added so far
+ *  @return size_t
+ */
+size_t ArrayBuilder::size() const
+{
+    return zend_hash_num_elements(Z_ARRVAL_P(_array._val));
+}
+
+/**
+ *  Retrieve the array that was built
+ *  @return Value
+ */
+Value ArrayBuilder::value()
+{
+    // move the array out of the builder
+    Value result(std::move(_array));
+
+    // the builder starts over with an empty array
+    array_init(_array._val);
+
+    // done
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
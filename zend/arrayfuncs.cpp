@@ -0,0 +1,402 @@
+/**
+ *  ArrayFuncs.cpp
+ *
+ *  Native implementations of the PHP array functions that are available
+ *  in the Php namespace (count(), array_keys(), in_array(), et cetera).
+ *  Calling these functions does not go through the function table of the
+ *  zend engine, but works directly on the hash tables.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Open the PHP namespace
+ */
+namespace Php {
+
+/**
+ *  Helper function to copy all elements from one hash table to the other,
+ *  with the same rules as array_merge(): numeric keys are renumbered, and
+ *  elements with string keys overwrite the existing element
+ *  @param  target
+ *  @param  source
+ */
+static void merge(HashTable *target, HashTable *source)
+{
+    // the key and value of each element
+    zend_string *key;
+    zval *entry;
+
+    // loop through the elements
+    ZEND_HASH_FOREACH_STR_KEY_VAL(source, key, entry)
+    {
+        // references that are not shared with anyone else are copied by value
+        if (Z_ISREF_P(entry) && Z_REFCOUNT_P(entry) == 1) entry = Z_REFVAL_P(entry);
+
+        // the array gets one more reference to the value
+        Z_TRY_ADDREF_P(entry);
+
+        // add the element
+        if (key) zend_hash_update(target, key, entry);
+        else zend_hash_next_index_insert_new(target, entry);
+    }
+    ZEND_HASH_FOREACH_END();
+}
+
+/**
+ *  Helper function to search for a value in a hash table
+ *  @param  haystack    The hash table
+ *  @param  needle      The value to search for
+ *  @param  strict      Use strict comparison?
+ *  @param  result      The key that was found (only set if found)
+ *  @return bool
+ */
+static bool search(HashTable *haystack, zval *needle, bool strict, zval *result)
+{
+    // the key and value of each element
+    zend_ulong index;
+    zend_string *key;
+    zval *entry;
+
+    // strict comparisons of integers and strings are the most common, they
+    // are checked without calling a generic comparison function
+    if (strict && Z_TYPE_P(needle) == IS_LONG)
+    {
+        // loop through the elements
+        ZEND_HASH_FOREACH_KEY_VAL(haystack, index, key, entry)
+        {
+            // dereference the value
+            ZVAL_DEREF(entry);
+
+            // skip if not the same
+            if (Z_TYPE_P(entry) != IS_LONG || Z_LVAL_P(entry) != Z_LVAL_P(needle)) continue;
+
+            // found it
+            if (key) ZVAL_STR_COPY(result, key); else ZVAL_LONG(result, index);
+            return true;
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    else if (strict && Z_TYPE_P(needle) == IS_STRING)
+    {
+        // loop through the elements
+        ZEND_HASH_FOREACH_KEY_VAL(haystack, index, key, entry)
+        {
+            // dereference the value
+            ZVAL_DEREF(entry);
+
+            // skip if not the same
+            if (Z_TYPE_P(entry) != IS_STRING || !zend_string_equals(Z_STR_P(entry), Z_STR_P(needle))) continue;
+
+            // found it
+            if (key) ZVAL_STR_COPY(result, key); else ZVAL_LONG(result, index);
+            return true;
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+    else
+    {
+        // loop through the elements
+        ZEND_HASH_FOREACH_KEY_VAL(haystack, index, key, entry)
+        {
+            // dereference the value
+            ZVAL_DEREF(entry);
+
+            // compare the values
+            if (strict ? !fast_is_identical_function(needle, entry) : !fast_equal_check_function(needle, entry)) continue;
+
+            // found it
+            if (key) ZVAL_STR_COPY(result, key); else ZVAL_LONG(result, index);
+            return true;
+        }
+        ZEND_HASH_FOREACH_END();
+    }
+
+    // not found
+    return false;
+}
+
+/**
+ *  Number of elements in an array
+ *  @param  value
+ *  @return Value
+ */
+Value count(const Value &value)
+{
+    // the actual value
+    zval *input = value._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("count", value);
+
+    // count the elements
+    return (int64_t)zend_array_count(Z_ARRVAL_P(input));
+}
+
+/**
+ *  All keys of an array
+ *  @param  value
+ *  @return Value
+ */
+Value array_keys(const Value &value)
+{
+    // the actual value
+    zval *input = value._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("array_keys", value);
+
+    // the hash table
+    HashTable *source = Z_ARRVAL_P(input);
+
+    // construct the result, with room for all keys
+    Value result;
+    array_init_size(result._val, zend_hash_num_elements(source));
+
+    // the key of each element
+    zend_ulong index;
+    zend_string *key;
+
+    // loop through the elements
+    ZEND_HASH_FOREACH_KEY(source, index, key)
+    {
+        // add the key
+        if (key) add_next_index_str(result._val, zend_string_copy(key));
+        else add_next_index_long(result._val, index);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    // done
+    return result;
+}
+
+/**
+ *  All values of an array
+ *  @param  value
+ *  @return Value
+ */
+Value array_values(const Value &value)
+{
+    // the actual value
+    zval *input = value._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("array_values", value);
+
+    // the hash table
+    HashTable *source = Z_ARRVAL_P(input);
+
+#if defined(HT_IS_PACKED) && defined(HT_IS_WITHOUT_HOLES)
+    // if the array already is a list, we can share it (unless elements were
+    // removed from the end, the next append would then get the wrong index)
+    if (HT_IS_PACKED(source) && HT_IS_WITHOUT_HOLES(source) && source->nNextFreeElement == (zend_long)zend_hash_num_elements(source)) return value;
+#endif
+
+    // construct the result, with room for all values
+    Value result;
+    array_init_size(result._val, zend_hash_num_elements(source));
+
+    // the value of each element
+    zval *entry;
+
+    // loop through the elements
+    ZEND_HASH_FOREACH_VAL(source, entry)
+    {
+        // references that are not shared with anyone else are copied by value
+        if (Z_ISREF_P(entry) && Z_REFCOUNT_P(entry) == 1) entry = Z_REFVAL_P(entry);
+
+        // add the value
+        Z_TRY_ADDREF_P(entry);
+        zend_hash_next_index_insert_new(Z_ARRVAL_P(result._val), entry);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    // done
+    return result;
+}
+
+/**
+ *  Add an element to the end of an array
+ *  @param  array
+ *  @param  value
+ *  @return Value       The new number of elements
+ */
+Value array_push(Value &array, const Value &value)
+{
+    // the actual array
+    zval *target = array._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(target) != IS_ARRAY) return call("array_push", array, value);
+
+    // the array could be shared with others
+    SEPARATE_ARRAY(target);
+
+    // the value to add (never as a reference)
+    zval *element = value._val.dereference();
+
+    // add the element
+    Z_TRY_ADDREF_P(element);
+    if (zend_hash_next_index_insert(Z_ARRVAL_P(target), element)) return (int64_t)zend_hash_num_elements(Z_ARRVAL_P(target));
+
+    // this fails when the highest possible index is already in use
+    Z_TRY_DELREF_P(element);
+
+    // report an error
+    throw Error("Cannot add element to the array as the next element is already occupied");
+}
+
+/**
+ *  Merge two arrays
+ *  @param  array1
+ *  @param  array2
+ *  @return Value
+ */
+Value array_merge(const Value &array1, const Value &array2)
+{
+    // the actual arrays
+    zval *input1 = array1._val.dereference();
+    zval *input2 = array2._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input1) != IS_ARRAY || Z_TYPE_P(input2) != IS_ARRAY) return call("array_merge", array1, array2);
+
+    // construct the result, with room for all elements
+    Value result;
+    array_init_size(result._val, zend_hash_num_elements(Z_ARRVAL_P(input1)) + zend_hash_num_elements(Z_ARRVAL_P(input2)));
+
+    // copy the elements
+    merge(Z_ARRVAL_P(result._val), Z_ARRVAL_P(input1));
+    merge(Z_ARRVAL_P(result._val), Z_ARRVAL_P(input2));
+
+    // done
+    return result;
+}
+
+/**
+ *  Extract a slice of an array
+ *  @param  array
+ *  @param  offset          Start position (negative to count from the end)
+ *  @param  length          Number of elements (null for all remaining elements, negative to stop before the end)
+ *  @param  preserve_keys   Should numeric keys be preserved?
+ *  @return Value
+ */
+Value array_slice(const Value &array, int64_t offset, const Value &length, bool preserve_keys)
+{
+    // the actual array
+    zval *input = array._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("array_slice", array, offset, length, preserve_keys);
+
+    // the hash table
+    HashTable *source = Z_ARRVAL_P(input);
+
+    // number of elements in the array
+    int64_t size = zend_hash_num_elements(source);
+
+    // the number of elements to extract
+    int64_t count = length.isNull() ? size : length.numericValue();
+
+    // normalize the offset and the length (the same way as php does)
+    if (offset > size) count = 0;
+    else if (offset < 0 && (offset = size + offset) < 0) offset = 0;
+    if (count < 0) count = size - offset + count;
+    else if (count > size - offset) count = size - offset;
+
+    // construct the result
+    Value result;
+    if (count <= 0) { array_init(result._val); return result; }
+    array_init_size(result._val, count);
+
+    // the key and value of each element, and the position in the array
+    zend_ulong index;
+    zend_string *key;
+    zval *entry;
+    int64_t position = 0;
+
+    // the position just after the slice (count is clamped, so this can not overflow)
+    int64_t end = offset + count;
+
+    // loop through the elements
+    ZEND_HASH_FOREACH_KEY_VAL(source, index, key, entry)
+    {
+        // skip elements before the slice, and stop after the slice
+        if (position++ < offset) continue;
+        if (position > end) break;
+
+        // references that are not shared with anyone else are copied by value
+        if (Z_ISREF_P(entry) && Z_REFCOUNT_P(entry) == 1) entry = Z_REFVAL_P(entry);
+
+        // the array gets one more reference to the value
+        Z_TRY_ADDREF_P(entry);
+
+        // add the element
+        if (key) zend_hash_add_new(Z_ARRVAL_P(result._val), key, entry);
+        else if (preserve_keys) zend_hash_index_add_new(Z_ARRVAL_P(result._val), index, entry);
+        else zend_hash_next_index_insert_new(Z_ARRVAL_P(result._val), entry);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    // done
+    return result;
+}
+
+/**
+ *  Search for a value in an array, and return its key
+ *  @param  needle
+ *  @param  haystack
+ *  @param  strict
+ *  @return Value       The key, or false if not found
+ */
+Value array_search(const Value &needle, const Value &haystack, bool strict)
+{
+    // the actual array
+    zval *input = haystack._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("array_search", needle, haystack, strict);
+
+    // the key that is found
+    Value result;
+
+    // search the array
+    if (search(Z_ARRVAL_P(input), needle._val.dereference(), strict, result._val)) return result;
+
+    // not found
+    return false;
+}
+
+/**
+ *  Check whether a value is in an array
+ *  @param  needle
+ *  @param  haystack
+ *  @param  strict
+ *  @return Value
+ */
+Value in_array(const Value &needle, const Value &haystack, bool strict)
+{
+    // the actual array
+    zval *input = haystack._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("in_array", needle, haystack, strict);
+
+    // the key that is found (not used)
+    zval key;
+
+    // search the array
+    if (!search(Z_ARRVAL_P(input), needle._val.dereference(), strict, &key)) return false;
+
+    // forget the key
+    zval_ptr_dtor(&key);
+
+    // found
+    return true;
+}
+
+/**
+ *  End of namespace
+ */
+}
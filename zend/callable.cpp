@@ -14,42 +14,133 @@
 namespace Php {
 
 /**
- *  Function that is called by the Zend engine every time that a function gets called
- *  @param  ht
+ *  Callables that were registered with a runtime callback (the deprecated
+ *  non-template API) do not have a handler of their own, they all share the
+ *  lookup() handler below. That handler finds the callable by the name of the
+ *  class and the function on the first call, and remembers it by the address
+ *  of the zend function for the calls after that.
+ *
+ *  The callables by their "classname::name", this map is filled when the
+ *  extension starts, and entries are removed when a callable is destructed.
+ *  @return std::unordered_map
+ */
+static std::unordered_map<std::string,Callable*> &registry()
+{
+    // deliberately leaked, extensions can still be unloaded during static destruction
+    static auto *callables = new std::unordered_map<std::string,Callable*>();
+
+    // expose the map
+    return *callables;
+}
+
+/**
+ *  Counter that is increased every time a callable is removed from the
+ *  registry, so that the per-thread caches know that they are outdated
+ */
+static std::atomic<unsigned> generation(0);
+
+/**
+ *  Per-thread cache of callables, by the zend function that is called
+ */
+struct LookupCache
+{
+    /**
+     *  The generation of the registry that the cache belongs to
+     *  @var unsigned
+     */
+    unsigned generation = 0;
+
+    /**
+     *  The callables that were already looked up
+     *  @var std::unordered_map
+     */
+    std::unordered_map<const zend_function*,Callable*> callables;
+};
+
+/**
+ *  The cache of the current thread
+ */
+static thread_local LookupCache cache;
+
+/**
+ *  The key under which a callable is stored in the registry
+ *  @param  classname   Name of the class (or nullptr for a function)
+ *  @param  name        Name of the function or method
+ *  @return std::string
+ */
+static std::string key(const char *classname, const char *name)
+{
+    return std::string(classname ? classname : "") + "::" + name;
+}
+
+/**
+ *  Find the callable for a zend function by its name
+ *  @param  function
+ *  @return Callable
+ */
+static Callable *resolve(const zend_function *function)
+{
+    // find the callable by the name of the class and the function
+    auto iter = registry().find(key(function->common.scope ? ZSTR_VAL(function->common.scope->name) : nullptr, ZSTR_VAL(function->common.function_name)));
+
+    // done
+    return iter == registry().end() ? nullptr : iter->second;
+}
+
+/**
+ *  Handler for callables that do not have a handler of their own
+ *  @param  execute_data
  *  @param  return_value
- *  @param  return_value_ptr
- *  @param  this_ptr
- *  @param  return_value_used
- *  @return integer
  */
-void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
+static void lookup(INTERNAL_FUNCTION_PARAMETERS)
 {
-    uint32_t argc       = EX(func)->common.num_args;
-    zend_arg_info* info = EX(func)->common.arg_info;
+    // the function that is called
+    auto *function = EX(func);
 
-#if PHP_VERSION_ID < 70200
-    // Sanity check
-    assert(info[argc].class_name != nullptr && info[argc].name == nullptr);
+    // forget the cached callables if some of them were destructed
+    unsigned current = generation.load(std::memory_order_relaxed);
+    if (cache.generation != current) { cache.callables.clear(); cache.generation = current; }
 
-    // the callable we are retrieving
-    Callable *callable = reinterpret_cast<Callable*>(info[argc].class_name);
-#else
-    // Sanity check
-    assert(ZEND_TYPE_IS_SET(info[argc].type) && info[argc].name == nullptr);
-    // the callable we are retrieving
-# if PHP_VERSION_ID < 80000
-    Callable *callable = reinterpret_cast<Callable*>(info[argc].type);
-# else
-    Callable *callable = reinterpret_cast<Callable*>(info[argc].type.ptr);
-# endif
-#endif
+    // the callable is only looked up by its name on the first call
+    Callable *&callable = cache.callables[function];
+    if (!callable) callable = resolve(function);
+
+    // this should not happen, all these functions were registered
+    if (!callable) { zend_error(E_ERROR, "Unable to call %s(): it was not registered", ZSTR_VAL(function->common.function_name)); return; }
+
+    // forward the call
+    callable->execute(INTERNAL_FUNCTION_PARAM_PASSTHRU);
+}
+
+/**
+ *  Destructor
+ */
+Callable::~Callable()
+{
+    // nothing to do if we were never registered for lookups by name
+    if (_key.empty()) return;
 
+    // remove ourselves from the registry (unless someone else took over the name)
+    auto iter = registry().find(_key);
+    if (iter != registry().end() && iter->second == this) registry().erase(iter);
+
+    // the caches of all threads are outdated
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ *  Function that is called by the shared handler every time that the function gets called
+ *  @param  execute_data
+ *  @param  return_value
+ */
+void Callable::execute(INTERNAL_FUNCTION_PARAMETERS)
+{
     // check if sufficient parameters were passed (for some reason this check
     // is not done by Zend, so we do it here ourselves)
-    if (ZEND_NUM_ARGS() < callable->_required)
+    if (ZEND_NUM_ARGS() < _required)
     {
         // PHP itself only generates a warning when this happens, so we do the same too
-        Php::warning << get_active_function_name() << "() expects at least " << callable->_required << " parameter(s), " << ZEND_NUM_ARGS() << " given" << std::flush;
+        Php::warning << get_active_function_name() << "() expects at least " << _required << " parameter(s), " << ZEND_NUM_ARGS() << " given" << std::flush;
 
         // and we return null
         RETURN_NULL();
@@ -63,7 +154,7 @@ void Callable::invoke(INTERNAL_FUNCTION_PARAMETERS)
         try
         {
             // get the result
-            Value result(callable->invoke(params));
+            Value result(invoke(params));
 
             // return a full copy of the zval, and do not destruct it
             RETVAL_ZVAL(result._val, 1, 0);
@@ -92,34 +183,25 @@ void Callable::initialize(zend_function_entry *entry, const char *classname, int
     if (_callback)
     {
         // that's nice, we simply install the callback
-        // no need to store any data in a lookup map
         entry->handler = _callback;
     }
+    else if (flags & ZEND_ACC_ABSTRACT)
+    {
+        // abstract methods (and the methods of interfaces) are never called,
+        // and zend expects them not to have a handler
+        entry->handler = nullptr;
+    }
     else
     {
-        // install ourselves in the extra argument
-#if PHP_VERSION_ID < 70200
-        _argv[_argc + 1].class_name = reinterpret_cast<const char*>(this);
-#elif PHP_VERSION_ID < 80000
-        // @todo    this is broken. the zend engine, from 7.2 onwards copies over
-        //          the struct and slices off the last element, because the num_args
-        //          is incorrect in their view. another place to put this may be
-        //          hiding it behind the fname
-       _argv[_argc + 1].type = reinterpret_cast<zend_type>(this);
-#else
-        // @todo    this is broken. the zend engine, from 7.2 onwards copies over
-        //          the struct and slices off the last element, because the num_args
-        //          is incorrect in their view. another place to put this may be
-        //          hiding it behind the fname
-       _argv[_argc + 1].type = ZEND_TYPE_INIT_PTR(this, IS_PTR, true, 0);
-#endif
+        // register ourselves, so that the shared handler can find us by our name
+        _key = key(classname, _name.data());
+        registry()[_key] = const_cast<Callable*>(this);
 
-        // we use our own invoke method, which does a lookup
-        // in the map we just installed ourselves in
-        entry->handler = &Callable::invoke;
+        // install the handler that forwards calls to us
+        entry->handler = &lookup;
     }
 
-    // fill the members of the entity, and hide a pointer to the current object in the name
+    // fill the members of the entity
     entry->fname = _name.data();
     entry->arg_info = _argv.get();
     entry->num_args = _argc;
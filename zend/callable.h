@@ -35,7 +35,7 @@ public:
         _callback(callback),
         _name(name),
         _argc(arguments.size()),
-        _argv(new zend_internal_arg_info[_argc + 2])
+        _argv(new zend_internal_arg_info[_argc + 1])
     {
         // the first record is initialized with information about the function,
         // so we skip that here
@@ -50,19 +50,6 @@ public:
             // fill the arg info
             fill(&_argv[i++], argument);
         }
-
-        // initialize all elements to null
-        _argv[i].name = nullptr;
-#if PHP_VERSION_ID < 80000
-        _argv[i].is_variadic = false;
-        _argv[i].pass_by_reference = false;
-#endif
-        // initialize the extra argument prior to 7.2
-#if PHP_VERSION_ID < 70200
-        _argv[i].class_name = nullptr;
-#elif PHP_VERSION_ID < 80000
-        _argv[i].type = 0;
-#endif
     }
 
     /**
@@ -101,7 +88,7 @@ public:
     /**
      *  Destructor
      */
-    virtual ~Callable() = default;
+    virtual ~Callable();
 
     /**
      *  Method that gets called every time the function is executed
@@ -110,6 +97,14 @@ public:
      */
     virtual Value invoke(Parameters &params) = 0;
 
+    /**
+     *  Method that is called by the shared handler that is installed for
+     *  callables that do not have a handler of their own
+     *  @param  execute_data    The call frame
+     *  @param  return_value    The return value
+     */
+    void execute(INTERNAL_FUNCTION_PARAMETERS);
+
     /**
      *  Fill a function entry
      *  @param  entry       Entry to be filled
@@ -169,6 +164,13 @@ protected:
      */
     std::unique_ptr<zend_internal_arg_info[]> _argv;
 
+    /**
+     *  The name under which this callable was registered for the shared
+     *  handler (empty if it has a handler of its own)
+     *  @var    std::string
+     */
+    mutable std::string _key;
+
     /**
      *  Private helper method to fill an argument object
      *  @param  info        object from the zend engine
@@ -260,18 +262,6 @@ protected:
         info->pass_by_reference = arg.byReference();
 #endif
     }
-
-    /**
-     *  Function that is called by the Zend engine every time that a function gets called
-     *  @param  ht
-     *  @param  return_value
-     *  @param  return_value_ptr
-     *  @param  this_ptr
-     *  @param  return_value_used
-     *  @return integer
-     */
-    static void invoke(INTERNAL_FUNCTION_PARAMETERS);
-
 };
 
 /**
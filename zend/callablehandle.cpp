@@ -0,0 +1,167 @@
+/**
+ *  CallableHandle.cpp
+ *
+ *  Implementation of the handle to a PHP function that is resolved only once
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+#include "execarguments.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  callable    Anything that can be called
+ */
+CallableHandle::CallableHandle(const Value &callable) : _callable(callable)
+{
+    // resolve the function
+    resolve();
+}
+
+/**
+ *  Constructor for a method of an object (or a static method of a class)
+ *  @param  object      The object or the name of the class
+ *  @param  method      Name of the method
+ */
+CallableHandle::CallableHandle(const Value &object, const char *method) : _callable(Type::Array)
+{
+    // the callable is an array holding the object and the method name
+    _callable.set(0, object);
+    _callable.set(1, method);
+
+    // resolve the method
+    resolve();
+}
+
+/**
+ *  Move constructor
+ *  @param  that
+ */
+CallableHandle::CallableHandle(CallableHandle &&that) _NOEXCEPT :
+    _callable(std::move(that._callable)),
+    _cache(that._cache),
+    _valid(that._valid)
+{
+    // the other object no longer owns the cache
+    that._cache = nullptr;
+    that._valid = false;
+}
+
+/**
+ *  Destructor
+ */
+CallableHandle::~CallableHandle()
+{
+    // forget the cache
+    delete _cache;
+}
+
+/**
+ *  Resolve the callable
+ */
+void CallableHandle::resolve()
+{
+    // the cache that is going to be filled
+    auto *cache = new zend_fcall_info_cache;
+
+    // possible error message
+    char *error = nullptr;
+
+    // look up the function
+    _valid = zend_is_callable_ex(_callable._val, nullptr, 0, nullptr, cache, &error);
+
+    // we do not need the error message
+    if (error) efree(error);
+
+    // methods that are handled by __call() are resolved into a trampoline that
+    // can only be used for a single call, such functions are not cached
+    // (zend_call_function() resolves them on every call)
+    if (_valid && !(cache->function_handler->common.fn_flags & ZEND_ACC_CALL_VIA_TRAMPOLINE)) { _cache = cache; return; }
+
+#if PHP_VERSION_ID >= 70300
+    // release the trampoline
+    if (_valid) zend_release_fcall_info_cache(cache);
+#else
+    // release the trampoline (this is what zend_release_fcall_info_cache() does in later versions)
+    if (_valid)
+    {
+        zend_string_release(cache->function_handler->common.function_name);
+        zend_free_trampoline(cache->function_handler);
+    }
+#endif
+
+    // the cache is not used
+    delete cache;
+}
+
+/**
+ *  Call the function with an array of arguments
+ *  @param  argc        Number of arguments
+ *  @param  argv        The arguments
+ *  @return Value
+ */
+Value CallableHandle::exec(int argc, Value argv[]) const
+{
+    // the function must exist
+    if (!_valid) throw Error("Invalid call to a function that does not exist");
+
+    // php does not call functions while an exception is pending (and it would
+    // reset the cache), the exception is handled when we return to php space
+    if (EG(exception)) return nullptr;
+
+    // array of zvals to pass to the function
+    ExecArguments args(argc, argv);
+
+    // the return zval
+    zval retval;
+
+    // information about the call
+    zend_fcall_info fci;
+    fci.size = sizeof(fci);
+    fci.retval = &retval;
+    fci.params = args.argv();
+    fci.param_count = args.argc();
+    fci.object = nullptr;
+#if PHP_VERSION_ID < 70100
+    fci.function_table = EG(function_table);
+    fci.symbol_table = nullptr;
+#endif
+#if PHP_VERSION_ID < 80000
+    fci.no_separation = 1;
+#else
+    fci.named_params = nullptr;
+#endif
+
+    // the function name is only used if the function was not cached
+    ZVAL_COPY_VALUE(&fci.function_name, _callable._val);
+
+    // call the function
+    if (zend_call_function(&fci, _cache) != SUCCESS) throw Error("Invalid call to a function that does not exist");
+
+    // no exception was active before the call, so any exception that is active
+    // now means that an exception or error occured during the call to php space
+    State::rethrowCurrent();
+
+    // leap out if nothing was returned
+    if (Z_ISUNDEF(retval)) return nullptr;
+
+    // wrap the retval in a val
+    Value result(&retval);
+
+    // destruct the retval (this just decrements the refcounter, which is ok, because
+    // it is already wrapped in a Php::Value so still has 1 reference)
+    zval_ptr_dtor(&retval);
+
+    // done
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
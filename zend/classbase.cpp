@@ -21,9 +21,9 @@ namespace Php {
 ClassBase::ClassBase(const char *classname, int flags)
 {
     // the flags hold a method-flag-value, this should be converted into a class-type
-    if (flags & Abstract) _impl = std::make_shared<ClassImpl>(classname, ClassType::Abstract);
-    else if (flags & Final) _impl = std::make_shared<ClassImpl>(classname, ClassType::Final);
-    else _impl = std::make_shared<ClassImpl>(classname, ClassType::Regular);
+    if (flags & Abstract) _impl = std::make_shared<ClassImpl>(classname, ClassType::Abstract, flags);
+    else if (flags & Final) _impl = std::make_shared<ClassImpl>(classname, ClassType::Final, flags);
+    else _impl = std::make_shared<ClassImpl>(classname, ClassType::Regular, flags);
 }
 
 /**
@@ -143,6 +143,18 @@ void ClassBase::implements(const ClassBase &interface) { _impl->implements(inter
  */
 void ClassBase::extends(const ClassBase &base) { _impl->extends(base._impl); }
 
+/**
+ *  Keep the memory of the C++ objects in a pool
+ *  @param  count           Number of objects per slab
+ */
+void ClassBase::pool(size_t count) { _impl->pool(count); }
+
+/**
+ *  Statistics about the pool
+ *  @return PoolStatistics
+ */
+PoolStatistics ClassBase::statistics() const { return _impl->statistics(); }
+
 /**
  *  End namespace
  */
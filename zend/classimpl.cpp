@@ -96,6 +96,31 @@ struct CallData
     ClassImpl *self;
 };
 
+/**
+ *  Helper function to get memory for the function data of a __call(),
+ *  __callStatic() or __invoke() call. Just like the Zend engine does for the
+ *  __call() methods of userspace classes, the trampoline function in the
+ *  executor globals is used if it is not already in use, so that most calls
+ *  do not need an allocation. The data is released with zend_free_trampoline()
+ *  (by the DelayedFree object in the call handler, or by the engine itself
+ *  when it only checked whether a method exists)
+ *  @return CallData
+ */
+static CallData *allocate()
+{
+    // the data must fit in the trampoline
+    static_assert(sizeof(CallData) <= sizeof(zend_function), "CallData does not fit in a zend_function");
+
+    // the trampoline is available if it has no function name
+    auto *data = EG(trampoline).common.function_name == nullptr ? (CallData *)&EG(trampoline) : (CallData *)emalloc(sizeof(CallData));
+
+    // reset everything to zero (in case future PHP versions add more fields)
+    memset(data, 0, sizeof(CallData));
+
+    // done
+    return data;
+}
+
 /**
  *  Handler function that runs the __call function
  *  @param  ...     All normal parameters for function calls
@@ -110,7 +135,7 @@ void ClassImpl::callMethod(INTERNAL_FUNCTION_PARAMETERS)
     const char *name = ZSTR_VAL(func->function_name);
     ClassBase *meta = data->self->_base;
 
-    // the data structure was allocated by ourselves in the getMethod or
+    // the data structure was filled by ourselves in the getMethod or
     // getStaticMethod functions, we no longer need it when the function falls
     // out of scope
     DelayedFree df(data);
@@ -154,7 +179,7 @@ void ClassImpl::callInvoke(INTERNAL_FUNCTION_PARAMETERS)
     // get self reference
     ClassBase *meta = data->self->_base;
 
-    // the data structure was allocated by ourselves in the getMethod or
+    // the data structure was filled by ourselves in the getMethod or
     // getStaticMethod functions, we no longer need it when the function falls
     // out of scope
     DelayedFree df(data);
@@ -213,21 +238,15 @@ zend_function *ClassImpl::getMethod(zend_object **object, zend_string *method, c
     // retrieve the class entry linked to this object
     auto *entry = (*object)->ce;
 
-    // this is peculiar behavior of the zend engine, we first are going to dynamically
-    // allocate memory holding all the properties of the __call method (we initially
-    // had an implementation here that used a static variable, and that worked too,
-    // but we'll follow thread safe implementation of the Zend engine here, although
-    // it is strange to allocate and free memory in one and the same method call (free()
-    // call happens in call_method()) (2024-10-13 extra info: the method_exists() 
-    // function and our own Value::isCallable() method expect this to be emalloc()-
-    // allocated buffer, because they both call zend_free_trampoline() (which is
-    // effectively an efree() call) on the returned function-structure)
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // this is peculiar behavior of the zend engine, we first are going to fill a
+    // structure holding all the properties of the __call method, which is released
+    // again in callMethod(). Note that the method_exists() function and our own
+    // Value::isCallable() method call zend_free_trampoline() on the returned
+    // function-structure, so it must be either the trampoline of the executor
+    // globals, or an emalloc()-allocated buffer
+    auto *data = allocate();
     auto *function = &data->func;
 
-    // reset everything to zero (in case future PHP versions add more fields)
-    memset(function, 0, sizeof(*function));
-
     // set all properties
     function->type              = ZEND_INTERNAL_FUNCTION;
     function->arg_flags[0]      = 0;
@@ -267,21 +286,18 @@ zend_function *ClassImpl::getStaticMethod(zend_class_entry *entry, zend_string *
     // did the default implementation do anything?
     if (defaultFunction) return defaultFunction;
 
-    // just like we did in getMethod() (see comment there) we are going to dynamically
-    // allocate data holding information about the function
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // just like we did in getMethod() (see comment there) we are going to fill
+    // a structure holding information about the function
+    auto *data = allocate();
     auto *function = &data->func;
 
-    // reset everything to zero (in case future PHP versions add more fields)
-    memset(function, 0, sizeof(*function));
-
     // set all properties for the function
     function->type              = ZEND_INTERNAL_FUNCTION;
     function->arg_flags[0]      = 0;
     function->arg_flags[1]      = 0;
     function->arg_flags[2]      = 0;
     function->fn_flags          = ZEND_ACC_CALL_VIA_HANDLER;
-    function->function_name     = nullptr;
+    function->function_name     = method;                       // should not be null, it marks the trampoline as being in use
     function->scope             = nullptr;
     function->prototype         = nullptr;
     function->num_args          = 0;
@@ -320,14 +336,11 @@ zend_result ClassImpl::getClosure(ZEND_OBJECT_OR_ZVAL object, zend_class_entry *
     // to fill the function parameter with all information about the invoke()
     // method that is going to get called
 
-    // just like we did for getMethod(), we're going to dynamically allocate memory
-    // with all information about the function
-    auto *data = (CallData *)emalloc(sizeof(CallData));
+    // just like we did for getMethod(), we're going to fill a structure with
+    // all information about the function
+    auto *data = allocate();
     auto *function = &data->func;
 
-    // reset everything to zero (in case future PHP versions add more fields)
-    memset(function, 0, sizeof(*function));
-
     // we're going to set all properties of the zend_internal_function struct
     function->type              = ZEND_INTERNAL_FUNCTION;
     function->arg_flags[0]      = 0;
@@ -388,42 +401,83 @@ zend_object_handlers *ClassImpl::objectHandlers()
     if (!_base->clonable()) _handlers.clone_obj = nullptr;
     else _handlers.clone_obj = &ClassImpl::cloneObject;
 
+    // which magic methods are overridden, and are there properties with callbacks
+    // (or properties that are initialized when they are first accessed)?
+    auto magic = _base->magic();
+
+    // does the class have a __clone() method that must be called for clones?
+    _clone = magic & ClassBase::MagicClone;
+    bool properties = !_properties.empty() || _lazy;
+
+    // typed arrays have their own handlers to access the elements
+    if (magic & ClassBase::MagicTypedArray)
+    {
+        _handlers.count_elements = &ClassImpl::countTypedElements;
+        _handlers.write_dimension = &ClassImpl::writeTypedDimension;
+        _handlers.read_dimension = &ClassImpl::readTypedDimension;
+        _handlers.has_dimension = &ClassImpl::hasTypedDimension;
+        _handlers.unset_dimension = &ClassImpl::unsetTypedDimension;
+    }
+
     // functions for the Countable interface
-    _handlers.count_elements = &ClassImpl::countElements;
+    else if (magic & ClassBase::MagicCount) _handlers.count_elements = &ClassImpl::countElements;
 
     // functions for the ArrayAccess interface
-    _handlers.write_dimension = &ClassImpl::writeDimension;
-    _handlers.read_dimension = &ClassImpl::readDimension;
-    _handlers.has_dimension = &ClassImpl::hasDimension;
-    _handlers.unset_dimension = &ClassImpl::unsetDimension;
+    if (!(magic & ClassBase::MagicTypedArray) && (magic & ClassBase::MagicArrayAccess))
+    {
+        _handlers.write_dimension = &ClassImpl::writeDimension;
+        _handlers.read_dimension = &ClassImpl::readDimension;
+        _handlers.has_dimension = &ClassImpl::hasDimension;
+        _handlers.unset_dimension = &ClassImpl::unsetDimension;
+    }
 
-    // functions for the magic properties handlers (__get, __set, __isset and __unset)
-    _handlers.write_property = &ClassImpl::writeProperty;
-    _handlers.read_property = &ClassImpl::readProperty;
-    _handlers.has_property = &ClassImpl::hasProperty;
-    _handlers.unset_property = &ClassImpl::unsetProperty;
+    // functions for the magic properties handlers (__get, __set, __isset and __unset),
+    // these are only needed if the class implements them, or has callback properties
+    if (properties || (magic & ClassBase::MagicSet)) _handlers.write_property = &ClassImpl::writeProperty;
+    if (properties || (magic & ClassBase::MagicGet)) _handlers.read_property = &ClassImpl::readProperty;
+    if (properties || (magic & ClassBase::MagicIsset)) _handlers.has_property = &ClassImpl::hasProperty;
+    if (properties || (magic & ClassBase::MagicUnset)) _handlers.unset_property = &ClassImpl::unsetProperty;
+
+    // lazy properties are also initialized when all properties are retrieved
+    // (var_dump, serialize, foreach) or when a pointer to a property is needed
+    if (_lazy) _handlers.get_properties = &ClassImpl::getProperties;
+    if (_lazy || _snapshot) _handlers.get_property_ptr_ptr = &ClassImpl::getPropertyPointer;
+
+#if PHP_VERSION_ID >= 70400
+    // the properties with callbacks are added when the object is exported
+    if (!_properties.empty()) _handlers.get_properties_for = &ClassImpl::getPropertiesFor;
+#endif
 
     // when a method is called (__call and __invoke)
-    _handlers.get_method = &ClassImpl::getMethod;
-    _handlers.get_closure = &ClassImpl::getClosure;
+    if (magic & ClassBase::MagicCall) _handlers.get_method = &ClassImpl::getMethod;
+    if (magic & ClassBase::MagicInvoke) _handlers.get_closure = &ClassImpl::getClosure;
 
     // register destructor and deallocator
     _handlers.dtor_obj = &ClassImpl::destructObject;
     _handlers.free_obj = &ClassImpl::freeObject;
 
     // handler to cast to a different type
-    _handlers.cast_object = &ClassImpl::cast;
+    if (magic & ClassBase::MagicCast) _handlers.cast_object = &ClassImpl::cast;
 
-    // method to compare two objects
+    // method to compare two objects (the default comparison looks at the properties)
 #if PHP_VERSION_ID < 80000
-    _handlers.compare_objects = &ClassImpl::compare;
+    if ((magic & ClassBase::MagicCompare) || _lazy) _handlers.compare_objects = &ClassImpl::compare;
 #else
-    _handlers.compare = &ClassImpl::compare;
+    if ((magic & ClassBase::MagicCompare) || _lazy) _handlers.compare = &ClassImpl::compare;
 #endif
 
-    // set the offset between our class implementation and
-    // the zend_object member in the allocated structure
-    _handlers.offset = ObjectImpl::offset();
+    // the compact layout is only possible if the object can be constructed in place
+    if (_compact && _base->size() == 0) _compact = false;
+
+    // set the offset between the start of the allocated structure and the
+    // zend_object member (for a compact layout the C++ object comes first)
+    _handlers.offset = _compact ? ObjectImpl::offset(_base->size()) : ObjectImpl::offset();
+
+#ifndef ZTS
+    // the pool is not used for compact objects (their memory is owned by zend), and neither in
+    // thread safe builds (the pool is shared by all threads, and is not protected by a lock)
+    if (_slab > 0 && !_compact && _base->size() > 0) _pool.reset(new ObjectPool(ObjectImpl::size(_base->size()), _slab));
+#endif
 
     // remember that object is now initialized
     _initialized = true;
@@ -453,36 +507,28 @@ int ClassImpl::compare(zval *val1, zval *val2)
     // prevent exceptions
     try
     {
-        // retrieve the class entry linked to this object
-        auto *entry = Z_OBJCE_P(val1);
-
-        // other object must be of the same type
-        if (entry != Z_OBJCE_P(val2)) throw NotImplemented();
-
-        // we need the C++ class meta-information object
-        ClassBase *meta = self(entry)->_base;
-
-        // get the base objects
-        Base *object1 = ObjectImpl::find(val1)->object();
-        Base *object2 = ObjectImpl::find(val2)->object();
-
-        // run the compare method
-        return meta->callCompare(object1, object2);
+        // both objects must be of the same type (one of them could also be
+        // something that is not an object at all)
+        if (Z_TYPE_P(val1) == IS_OBJECT && Z_TYPE_P(val2) == IS_OBJECT && Z_OBJCE_P(val1) == Z_OBJCE_P(val2))
+        {
+            // we need the C++ class meta-information object
+            ClassBase *meta = self(Z_OBJCE_P(val1))->_base;
+
+            // the handler could also be installed for lazy properties only, without a __compare() method
+            if (meta->magic() & ClassBase::MagicCompare)
+            {
+                // get the base objects
+                Base *object1 = ObjectImpl::find(val1)->object();
+                Base *object2 = ObjectImpl::find(val2)->object();
+
+                // run the compare method
+                return meta->callCompare(object1, object2);
+            }
+        }
     }
     catch (const NotImplemented &exception)
     {
-        // it was not implemented, do we have a default?
-#if PHP_VERSION_ID < 80000
-        if (!std_object_handlers.compare_objects) return 1;
-
-        // call default
-        return std_object_handlers.compare_objects(val1, val2);
-#else
-        if (!std_object_handlers.compare) return 1;
-
-        // call default
-        return std_object_handlers.compare(val1, val2);
-#endif
+        // the __compare() method fell back on the default implementation
     }
     catch (Throwable &throwable)
     {
@@ -492,6 +538,23 @@ int ClassImpl::compare(zval *val1, zval *val2)
         // what shall we return here...
         return 1;
     }
+
+    // the default implementation compares the properties, so lazy properties must be initialized
+    if (Z_TYPE_P(val1) == IS_OBJECT && lazy(Z_OBJ_HT_P(val1))) ObjectImpl::find(val1)->materialize();
+    if (Z_TYPE_P(val2) == IS_OBJECT && lazy(Z_OBJ_HT_P(val2))) ObjectImpl::find(val2)->materialize();
+
+    // it was not implemented, do we have a default?
+#if PHP_VERSION_ID < 80000
+    if (!std_object_handlers.compare_objects) return 1;
+
+    // call default
+    return std_object_handlers.compare_objects(val1, val2);
+#else
+    if (!std_object_handlers.compare) return 1;
+
+    // call default
+    return std_object_handlers.compare(val1, val2);
+#endif
 }
 
 /**
@@ -519,38 +582,48 @@ zend_result ClassImpl::cast(ZEND_OBJECT_OR_ZVAL val, zval *retval, int type)
     // we need the C++ class meta-information object
     ClassBase *meta = self(entry)->_base;
 
-    // when the magic function it not implemented, an exception will be thrown,
-    // and the extension may throw a Php::Exception
+    // the magic method that is needed for the cast
+    int needed = 0;
+
+    // check type
+    switch ((Type)type) {
+        case Type::Numeric:     needed = ClassBase::MagicToInteger;     break;
+        case Type::Float:       needed = ClassBase::MagicToFloat;       break;
+        case Type::Bool:        needed = ClassBase::MagicToBool;        break;
+        case Type::String:      needed = ClassBase::MagicToString;      break;
+        default:                                                        break;
+    }
+
+    // the extension may throw a Php::Exception
     try
     {
-        // the result value
-        Value result;
-
-        // check type
-        switch ((Type)type) {
-            case Type::Numeric:     result = meta->callToInteger(object);   break;
-            case Type::Float:       result = meta->callToFloat(object);     break;
-            case Type::Bool:        result = meta->callToBool(object);      break;
-            case Type::String:      result = meta->callToString(object);    break;
-            default:                throw NotImplemented();                 break;
-        }
+        // is the magic method implemented?
+        if (meta->magic() & needed)
+        {
+            // the result value
+            Value result;
+
+            // check type
+            switch ((Type)type) {
+                case Type::Numeric:     result = meta->callToInteger(object);   break;
+                case Type::Float:       result = meta->callToFloat(object);     break;
+                case Type::Bool:        result = meta->callToBool(object);      break;
+                default:                result = meta->callToString(object);    break;
+            }
 
-        // @todo do we turn into endless conversion if the __toString object returns 'this' ??
-        // (and if it does: who cares? If the extension programmer is stupid, why do we have to suffer?)
+            // @todo do we turn into endless conversion if the __toString object returns 'this' ??
+            // (and if it does: who cares? If the extension programmer is stupid, why do we have to suffer?)
 
-        // overwrite the result
-        ZVAL_DUP(retval, result._val);
+            // overwrite the result
+            ZVAL_DUP(retval, result._val);
 
-        // done
-        return SUCCESS;
+            // done
+            return SUCCESS;
+        }
     }
     catch (const NotImplemented &exception)
     {
-        // is there a default?
-        if (!std_object_handlers.cast_object) return FAILURE;
-
-        // call default
-        return std_object_handlers.cast_object(val, retval, type);
+        // the magic method fell back on the default implementation
     }
     catch (Throwable &throwable)
     {
@@ -560,6 +633,12 @@ zend_result ClassImpl::cast(ZEND_OBJECT_OR_ZVAL val, zval *retval, int type)
         // done
         return FAILURE;
     }
+
+    // is there a default?
+    if (!std_object_handlers.cast_object) return FAILURE;
+
+    // call default
+    return std_object_handlers.cast_object(val, retval, type);
 }
 
 /**
@@ -583,25 +662,31 @@ zend_object *ClassImpl::cloneObject(ZEND_OBJECT_OR_ZVAL val)
     // retrieve the old object, which we are going to copy
     ObjectImpl *old_object = ObjectImpl::find(val);
 
-    // create a new base c++ object
-    auto *cpp = meta->clone(old_object->object());
+    // the handlers for the object
+    auto *handlers = impl->objectHandlers();
+
+    // the new object, the C++ object is copy-constructed, and for classes with a compact
+    // layout or a pool it is constructed in the memory that is allocated for the object
+    // (the declared properties are not initialized, they are copied right after this)
+    ObjectImpl *new_object = nullptr;
+    if (impl->_compact) new_object = ObjectImpl::create(entry, meta, handlers, old_object->object());
+    else if (impl->_pool) new_object = ObjectImpl::create(entry, meta, handlers, impl->_pool.get(), old_object->object());
+    else if (auto *cpp = meta->clone(old_object->object())) new_object = new ObjectImpl(entry, cpp, handlers, 1, false);
 
     // report error on failure (this does not occur because the cloneObject()
     // method is only installed as handler when we have seen that there is indeed
     // a copy constructor). Because this function is directly called from the
     // Zend engine, we can call zend_error() (which does a longjmp()) to throw
     // an exception back to the Zend engine)
-    if (!cpp) zend_error(E_ERROR, "Unable to clone %s", entry->name->val);
-
-    // store the object
-    auto *new_object = new ObjectImpl(entry, cpp, impl->objectHandlers(), 1);
+    if (!new_object) zend_error(E_ERROR, "Unable to clone %s", entry->name->val);
 
-    // clone the members (this will also call the __clone() function if the user
-    // had registered that as a visible method)
-    zend_objects_clone_members(new_object->php(), old_object->php());
+    // copy the properties into the uninitialized slots (this will also call the
+    // __clone() function if the user had registered that as a visible method)
+    new_object->clone(old_object);
 
-    // was a custom clone method installed? If not we call the magic c++ __clone method
-    if (!entry->clone) meta->callClone(cpp);
+    // was a custom clone method installed? If not we call the magic c++ __clone method,
+    // but only if the class really has one
+    if (!entry->clone && impl->_clone) meta->callClone(new_object->object());
 
     // done
     return new_object->php();
@@ -851,6 +936,250 @@ void ClassImpl::unsetDimension(ZEND_OBJECT_OR_ZVAL object, zval *member)
     }
 }
 
+/**
+ *  Helper function to find the typed array behind an object
+ *  @param  object
+ *  @return TypedArrayBase
+ */
+static TypedArrayBase *typedArray(ZEND_OBJECT_OR_ZVAL object)
+{
+    // the handlers are only installed for classes derived from TypedArrayBase
+    return static_cast<TypedArrayBase*>(ObjectImpl::find(object)->object());
+}
+
+/**
+ *  Helper function to convert an offset of a typed array into a number. Only
+ *  integers and strings that hold an integer (the strings that php turns into
+ *  integer keys of arrays) are accepted, for other offsets an error is thrown
+ *  @param  offset          The offset
+ *  @param  result          Where to store the number
+ *  @return bool            Is this a valid offset?
+ */
+static bool typedOffset(zval *offset, zend_long *result)
+{
+    // the [] operator without an offset is only valid for appending
+    if (!offset) { zend_throw_error(nullptr, "Cannot use [] for reading"); return false; }
+
+    // most offsets are integers already
+    ZVAL_DEREF(offset);
+    if (Z_TYPE_P(offset) == IS_LONG) { *result = Z_LVAL_P(offset); return true; }
+
+    // strings must hold an integer
+    zend_ulong index;
+    if (Z_TYPE_P(offset) == IS_STRING && ZEND_HANDLE_NUMERIC_STR(Z_STRVAL_P(offset), Z_STRLEN_P(offset), index)) { *result = (zend_long)index; return true; }
+
+    // floats, null and other types would silently address a different element
+    zend_type_error("Illegal offset type");
+    return false;
+}
+
+/**
+ *  Helper function to check whether an offset is in range of a typed array
+ *  @param  array           The typed array
+ *  @param  offset          The offset
+ *  @param  index           Where to store the index
+ *  @return bool            Is the index in range?
+ */
+static bool typedIndex(TypedArrayBase *array, zend_long offset, size_t *index)
+{
+    // check the range
+    if (offset < 0 || (size_t)offset >= array->size()) return false;
+
+    // store the index
+    *index = (size_t)offset;
+    return true;
+}
+
+/**
+ *  Function that is called when a typed array is read with the [] operator
+ *  @param  object          The object on which it is called
+ *  @param  offset          The index
+ *  @param  type            The type of the variable
+ *  @param  rv              Pointer to where to store the data
+ *  @return zval
+ */
+zval *ClassImpl::readTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, int type, zval *rv)
+{
+    // the typed array, the offset and the index
+    auto *array = typedArray(object);
+    zend_long position;
+    size_t index;
+
+    // the offset must be valid
+    if (!typedOffset(offset, &position)) return &EG(uninitialized_zval);
+
+    // the index must be in range
+    if (!typedIndex(array, position, &index))
+    {
+        // isset() and ?? do not report errors
+        if (type != BP_VAR_IS) zend_throw_error(nullptr, "Offset is out of range");
+
+        // the result is null
+        return &EG(uninitialized_zval);
+    }
+
+    // store the element in the return value
+    if (array->floating()) ZVAL_DOUBLE(rv, array->floatAt(index));
+    else ZVAL_LONG(rv, array->integerAt(index));
+
+    // done
+    return rv;
+}
+
+/**
+ *  Function that is called when a typed array is written with the [] operator
+ *  @param  object          The object on which it is called
+ *  @param  offset          The index (nullptr when appending)
+ *  @param  value           The new value
+ */
+void ClassImpl::writeTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, zval *value)
+{
+    // the typed array, the offset and the index
+    auto *array = typedArray(object);
+    zend_long position;
+    size_t index = 0;
+
+    // the offset must be valid and in range (unless an element is appended)
+    if (offset && !typedOffset(offset, &position)) return;
+    if (offset && !typedIndex(array, position, &index)) { zend_throw_error(nullptr, "Offset is out of range"); return; }
+
+    // the actual value
+    ZVAL_DEREF(value);
+
+    // the container may throw (std::bad_alloc when appending)
+    try
+    {
+        // numbers of the right type do not have to be converted, floats are
+        // also passed on as they are to integer arrays (the array saturates
+        // them, while the conversion by php wraps or gives zero)
+        if (array->floating() || Z_TYPE_P(value) == IS_DOUBLE)
+        {
+            double number = Z_TYPE_P(value) == IS_DOUBLE ? Z_DVAL_P(value) : zval_get_double(value);
+            if (offset) array->assign(index, number); else array->append(number);
+        }
+        else
+        {
+            int64_t number = Z_TYPE_P(value) == IS_LONG ? Z_LVAL_P(value) : zval_get_long(value);
+            if (offset) array->assign(index, number); else array->append(number);
+        }
+    }
+    catch (const std::exception &exception)
+    {
+        // report the error to user space
+        zend_throw_error(nullptr, "%s", exception.what());
+    }
+}
+
+/**
+ *  Function that is called when isset() or empty() is used on an element of a typed array
+ *  @param  object          The object on which it is called
+ *  @param  offset          The index
+ *  @param  check_empty     Was this an isset() call, or an empty() call?
+ *  @return bool
+ */
+int ClassImpl::hasTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, int check_empty)
+{
+    // the typed array, the offset and the index
+    auto *array = typedArray(object);
+    zend_long position;
+    size_t index;
+
+    // the offset must be valid and in range
+    if (!typedOffset(offset, &position) || !typedIndex(array, position, &index)) return false;
+
+    // for isset() we are done, otherwise the element must not be zero
+    if (!check_empty) return true;
+    return array->floating() ? array->floatAt(index) != 0.0 : array->integerAt(index) != 0;
+}
+
+/**
+ *  Function that is called when unset() is used on an element of a typed array
+ *  @param  object          The object on which it is called
+ *  @param  offset          The index
+ */
+void ClassImpl::unsetTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset)
+{
+    // elements can not be removed
+    zend_throw_error(nullptr, "Elements can not be removed from a typed array");
+}
+
+/**
+ *  Function that is used to count the number of elements in a typed array
+ *  @param  object
+ *  @param  count
+ *  @return int
+ */
+#if PHP_VERSION_ID < 80200
+int ClassImpl::countTypedElements(ZEND_OBJECT_OR_ZVAL object, zend_long *count)
+#else
+zend_result ClassImpl::countTypedElements(ZEND_OBJECT_OR_ZVAL object, zend_long *count)
+#endif
+{
+    // the size is known right away
+    *count = typedArray(object)->size();
+
+    // done
+    return SUCCESS;
+}
+
+/**
+ *  Helper method to find a property with a getter and setter
+ *
+ *  @param  entry       Class entry of the object
+ *  @param  name        Name of the property
+ *  @param  cache_slot  Runtime cache slot (can be nullptr)
+ *  @return Property    The property, or nullptr if it does not exist
+ */
+Property *ClassImpl::lookup(zend_class_entry *entry, ZEND_STRING_OR_ZVAL name, void **cache_slot) const
+{
+    // nothing to find if the class has no properties with callbacks
+    if (_lookup.empty()) return nullptr;
+
+    // zend itself (and the default handlers) store the class entry in the first
+    // cache slot and the property offset in the second one, and the engine reads
+    // the offset directly when the class entry matches. To prevent that our own
+    // data is ever mistaken for an offset, we store the class entry with the
+    // lowest bit set, which never matches a real class entry
+    void *tag = (void *)((uintptr_t)entry | 1);
+
+    // was the property already resolved by this opline?
+    if (cache_slot && cache_slot[0] == tag) return (Property *)cache_slot[1];
+
+#if PHP_VERSION_ID < 80000
+    // up to php 7.x the name is passed as a zval, which does not have to be a string
+    if (Z_TYPE_P(name) != IS_STRING)
+    {
+        // convert it to a string (this is rare, so we do not bother to cache it)
+        zend_string *str = zval_get_string(name);
+        auto iter = _lookup.find(str);
+        zend_string_release(str);
+
+        // expose the result
+        return iter == _lookup.end() ? nullptr : iter->second;
+    }
+
+    // find the property
+    auto iter = _lookup.find(Z_STR_P(name));
+#else
+    // find the property
+    auto iter = _lookup.find(name);
+#endif
+
+    // the property that was found
+    Property *result = iter == _lookup.end() ? nullptr : iter->second;
+
+    // remember it for the next time this opline is executed (we also store
+    // the misses, so that properties handled by __get() are also only looked up once)
+    if (cache_slot)
+    {
+        cache_slot[0] = tag;
+        cache_slot[1] = result;
+    }
+
+    // done
+    return result;
+}
+
 /**
  *  Helper method to turn a property into a zval
  *
@@ -921,6 +1250,9 @@ zval *ClassImpl::readProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL na
     // from PHP. If someone wants to get a reference to such an internal variable,
     // that is in most cases simply impossible.
 
+    // reading a property to modify it invalidates the snapshot of the properties
+    if (type != BP_VAR_R && type != BP_VAR_IS) ObjectImpl::find(object)->invalidate();
+
     // retrieve the object and class
     Base *base = ObjectImpl::find(object)->object();
 
@@ -935,35 +1267,21 @@ zval *ClassImpl::readProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL na
     ClassImpl *impl = self(entry);
     ClassBase *meta = impl->_base;
 
-    // the default implementation throws an exception, so by catching
-    // the exception we know if the object was implemented by the user or not
+    // user code may throw an exception
     try
     {
-        // convert name to a Value object
-        Value key(name);
-
         // is it a property with a callback?
-        auto iter = impl->_properties.find(key);
+        auto *property = impl->lookup(entry, name, cache_slot);
 
         // was it found?
-        if (iter == impl->_properties.end())
-        {
-            // retrieve value from the __get method
-            return toZval(meta->callGet(base, key), type, rv);
-        }
-        else
-        {
-            // get the value
-            return toZval(iter->second->get(base), type, rv);
-        }
+        if (property) return toZval(property->get(base), type, rv);
+
+        // retrieve value from the __get method (if it was overridden)
+        if (meta->magic() & ClassBase::MagicGet) return toZval(meta->callGet(base, Value(name)), type, rv);
     }
     catch (const NotImplemented &exception)
     {
-        // __get() function was not overridden by the user
-        if (!std_object_handlers.read_property) return nullptr;
-
-        // call default
-        return std_object_handlers.read_property(object, name, type, cache_slot, rv);
+        // the __get() method fell back on the default implementation
     }
     catch (Throwable &throwable)
     {
@@ -973,6 +1291,15 @@ zval *ClassImpl::readProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL na
         // unreachable (or is it?)
         return Value(nullptr).detach(false);
     }
+
+    // __get() function was not overridden by the user
+    if (!std_object_handlers.read_property) return nullptr;
+
+    // the default implementation needs the declared properties
+    ObjectImpl::find(object)->materialize();
+
+    // call default
+    return std_object_handlers.read_property(object, name, type, cache_slot, rv);
 }
 
 /**
@@ -989,6 +1316,9 @@ zval *ClassImpl::readProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL na
  */
 PHP_WRITE_PROP_HANDLER_TYPE ClassImpl::writeProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name, zval *value, void **cache_slot)
 {
+    // the snapshot of the properties (if there is one) is no longer valid
+    ObjectImpl::find(object)->invalidate();
+
     // retrieve the object and class
     Base *base = ObjectImpl::find(object)->object();
 
@@ -1003,26 +1333,17 @@ PHP_WRITE_PROP_HANDLER_TYPE ClassImpl::writeProperty(ZEND_OBJECT_OR_ZVAL object,
     ClassImpl *impl = self(entry);
     ClassBase *meta = impl->_base;
 
-    // the default implementation throws an exception, if we catch that
-    // we know for sure that the user has not overridden the __set method
+    // user code may throw an exception
     try
     {
-        // wrap the name
-        Value key(name);
-
         // check if the property has a callback
-        auto iter = impl->_properties.find(key);
+        auto *property = impl->lookup(entry, name, cache_slot);
 
         // is it set?
-        if (iter == impl->_properties.end())
-        {
-            // use the __set method
-            meta->callSet(base, key, value);
-        }
-        else
+        if (property)
         {
             // check if it could be set
-            if (iter->second->set(base, value)) {
+            if (property->set(base, value)) {
 #if PHP_VERSION_ID < 70400
                 return;
 #else
@@ -1031,37 +1352,51 @@ PHP_WRITE_PROP_HANDLER_TYPE ClassImpl::writeProperty(ZEND_OBJECT_OR_ZVAL object,
             }
 
             // read-only property
-            zend_error(E_ERROR, "Unable to write to read-only property %s", (const char *)key);
+            zend_error(E_ERROR, "Unable to write to read-only property %s", (const char *)Value(name));
         }
-    }
-    catch (const NotImplemented &exception)
-    {
-        // __set() function was not overridden by user, check if there is a default
-        if (!std_object_handlers.write_property) {
+        else if (meta->magic() & ClassBase::MagicSet)
+        {
+            // use the __set method
+            meta->callSet(base, Value(name), value);
 #if PHP_VERSION_ID < 70400
             return;
 #else
             return value;
 #endif
         }
-
-        // call the default
-        std_object_handlers.write_property(object, name, value, cache_slot);
+    }
+    catch (const NotImplemented &exception)
+    {
+        // the __set() method fell back on the default implementation
+    }
+    catch (Throwable &throwable)
+    {
+        // object was not caught by the extension, let it end up in user space
+        throwable.rethrow();
 #if PHP_VERSION_ID < 70400
         return;
 #else
         return value;
 #endif
     }
-    catch (Throwable &throwable)
-    {
-        // object was not caught by the extension, let it end up in user space
-        throwable.rethrow();
+
+    // __set() function was not overridden by user, check if there is a default
+    if (!std_object_handlers.write_property) {
+#if PHP_VERSION_ID < 70400
+        return;
+#else
+        return value;
+#endif
     }
+
+    // the default implementation needs the declared properties
+    ObjectImpl::find(object)->materialize();
+
+    // call the default
 #if PHP_VERSION_ID < 70400
-    return;
+    std_object_handlers.write_property(object, name, value, cache_slot);
 #else
-    return value;
+    return std_object_handlers.write_property(object, name, value, cache_slot);
 #endif
 }
 
@@ -1086,13 +1421,9 @@ PHP_WRITE_PROP_HANDLER_TYPE ClassImpl::writeProperty(ZEND_OBJECT_OR_ZVAL object,
  */
 int ClassImpl::hasProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name, int has_set_exists, void **cache_slot)
 {
-    // the default implementation throws an exception, if we catch that
-    // we know for sure that the user has not overridden the __isset method
+    // user code may throw an exception
     try
     {
-        // get the cpp object
-        Base *base = ObjectImpl::find(object)->object();
-
         // retrieve the class entry linked to this object
 #if PHP_VERSION_ID < 80000
         auto *entry = Z_OBJCE_P(object);
@@ -1104,34 +1435,37 @@ int ClassImpl::hasProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name,
         ClassImpl *impl = self(entry);
         ClassBase *meta = impl->_base;
 
-        // convert the name to a Value object
-        Value key(name);
-
         // check if this is a callback property
-        if (impl->_properties.find(key) != impl->_properties.end()) return true;
+        if (impl->lookup(entry, name, cache_slot)) return true;
 
-        // call the C++ object
-        if (!meta->callIsset(base, key)) return false;
+        // was the __isset method overridden?
+        if (meta->magic() & ClassBase::MagicIsset)
+        {
+            // convert the name to a Value object
+            Value key(name);
+
+            // get the cpp object
+            Base *base = ObjectImpl::find(object)->object();
+
+            // call the C++ object
+            if (!meta->callIsset(base, key)) return false;
 
-        // property exists, but what does the user want to know
-        if (has_set_exists == 2) return true;
+            // property exists, but what does the user want to know
+            if (has_set_exists == 2) return true;
 
-        // we have to retrieve the property
-        Value value = meta->callGet(base, key);
+            // we have to retrieve the property
+            Value value = meta->callGet(base, key);
 
-        // should we check on NULL?
-        switch (has_set_exists) {
-        case 0:     return value.type() != Type::Null;
-        default:    return value.boolValue();
+            // should we check on NULL?
+            switch (has_set_exists) {
+            case 0:     return value.type() != Type::Null;
+            default:    return value.boolValue();
+            }
         }
     }
     catch (const NotImplemented &exception)
     {
-        // __isset was not implemented, do we have a default?
-        if (!std_object_handlers.has_property) return 0;
-
-        // call default
-        return std_object_handlers.has_property(object, name, has_set_exists, cache_slot);
+        // the __isset() method fell back on the default implementation
     }
     catch (Throwable &throwable)
     {
@@ -1141,6 +1475,15 @@ int ClassImpl::hasProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name,
         // unreachable
         return false;
     }
+
+    // __isset was not implemented, do we have a default?
+    if (!std_object_handlers.has_property) return 0;
+
+    // the default implementation needs the declared properties
+    ObjectImpl::find(object)->materialize();
+
+    // call default
+    return std_object_handlers.has_property(object, name, has_set_exists, cache_slot);
 }
 
 /**
@@ -1154,8 +1497,10 @@ int ClassImpl::hasProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name,
  */
 void ClassImpl::unsetProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL member, void **cache_slot)
 {
-    // the default implementation throws an exception, if we catch that
-    // we know for sure that the user has not overridden the __unset method
+    // the snapshot of the properties (if there is one) is no longer valid
+    ObjectImpl::find(object)->invalidate();
+
+    // user code may throw an exception
     try
     {
         // retrieve the class entry linked to this object
@@ -1167,32 +1512,151 @@ void ClassImpl::unsetProperty(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL me
         // we need the C++ class meta-information object
         ClassImpl *impl = self(entry);
 
-        // property name
-        Value name(member);
-
-        // is this a callback property?
-        auto iter = impl->_properties.find(name);
-
-        // if the property does not exist, we forward to the __unset
-        if (iter == impl->_properties.end()) impl->_base->callUnset(ObjectImpl::find(object)->object(), member);
-
         // callback properties cannot be unset
-        zend_error(E_ERROR, "Property %s can not be unset", (const char *)name);
+        if (impl->lookup(entry, member, cache_slot)) zend_error(E_ERROR, "Property %s can not be unset", (const char *)Value(member));
+
+        // forward to the __unset method (if it was overridden)
+        else if (impl->_base->magic() & ClassBase::MagicUnset) return impl->_base->callUnset(ObjectImpl::find(object)->object(), Value(member));
     }
     catch (const NotImplemented &exception)
     {
-        // __unset was not implemented, do we have a default?
-        if (!std_object_handlers.unset_property) return;
-
-        // call the default
-        std_object_handlers.unset_property(object, member, cache_slot);
+        // the __unset() method fell back on the default implementation
     }
     catch (Throwable &throwable)
     {
         // object was not caught by the extension, let it end up in user space
         throwable.rethrow();
+
+        // unreachable
+        return;
+    }
+
+    // __unset was not implemented, do we have a default?
+    if (!std_object_handlers.unset_property) return;
+
+    // the default implementation needs the declared properties
+    ObjectImpl::find(object)->materialize();
+
+    // call the default
+    std_object_handlers.unset_property(object, member, cache_slot);
+}
+
+/**
+ *  Function that is called to retrieve all properties of an object with lazy
+ *  properties (for example by var_dump(), serialize() or in a foreach loop)
+ *  @param  object          The object on which it is called
+ *  @return HashTable
+ */
+HashTable *ClassImpl::getProperties(ZEND_OBJECT_OR_ZVAL object)
+{
+    // the declared properties must be part of the table
+    ObjectImpl::find(object)->materialize();
+
+    // call the default
+    return std_object_handlers.get_properties(object);
+}
+
+/**
+ *  Function that is called when a pointer to a property of an object with
+ *  lazy properties is needed (for example for $object->x[] = 1 or $object->x++)
+ *  @param  object          The object on which it is called
+ *  @param  name            The name of the property
+ *  @param  type            The type of access
+ *  @param  cache_slot      The cache slot used
+ *  @return zval
+ */
+zval *ClassImpl::getPropertyPointer(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name, int type, void **cache_slot)
+{
+    // retrieve the object
+    ObjectImpl *instance = ObjectImpl::find(object);
+
+    // the pointer could point to one of the declared properties, and it
+    // is most likely used to modify the property
+    instance->materialize();
+    instance->invalidate();
+
+    // call the default
+    return std_object_handlers.get_property_ptr_ptr(object, name, type, cache_slot);
+}
+
+#if PHP_VERSION_ID >= 70400
+/**
+ *  Function that is called when an object is exported by var_dump(), var_export(),
+ *  json_encode() or an array cast. The values of all properties with callbacks
+ *  are retrieved in one pass, and added to the regular properties.
+ *  @param  object          The object to export
+ *  @param  purpose         Why is it exported?
+ *  @return HashTable       Table with a reference that is released by the caller
+ */
+HashTable *ClassImpl::getPropertiesFor(zend_object *object, zend_prop_purpose purpose)
+{
+    // serialize() only stores the regular properties (otherwise unserialize() would
+    // write to the properties with callbacks, some of which may be read-only), and
+    // a __debugInfo() method decides by itself what var_dump() shows
+    if (purpose == ZEND_PROP_PURPOSE_SERIALIZE) return zend_std_get_properties_for(object, purpose);
+    if (purpose == ZEND_PROP_PURPOSE_DEBUG && object->ce->__debugInfo) return zend_std_get_properties_for(object, purpose);
+
+    // we need the C++ class meta-information object, and our own object
+    ClassImpl *impl = self(object->ce);
+    ObjectImpl *instance = ObjectImpl::find(object);
+
+    // the values of the properties with callbacks (from an earlier call, if they were kept)
+    HashTable *values = instance->snapshot();
+
+    // the caller gets its own reference to a snapshot
+    if (values) GC_ADDREF(values);
+
+    // otherwise we call all the getters
+    else
+    {
+        // create the table, we already know its size
+        values = zend_new_array(impl->_exported.size());
+
+        // user code may throw an exception
+        try
+        {
+            // the C++ object
+            Base *base = instance->object();
+
+            // move the values into the table (the names are interned strings)
+            for (auto &property : impl->_exported)
+            {
+                Value value = property.second->get(base);
+                zend_hash_add_new(values, property.first, value._val);
+                ZVAL_UNDEF(value._val);
+            }
+        }
+        catch (Throwable &throwable)
+        {
+            // the values are not complete
+            zend_array_destroy(values);
+
+            // object was not caught by the extension, let it end up in user space
+            throwable.rethrow();
+
+            // only export the regular properties
+            return zend_std_get_properties_for(object, purpose);
+        }
+
+        // keep the values for the next time
+        if (impl->_snapshot) { GC_ADDREF(values); instance->snapshot(values); }
     }
+
+    // if the object has no regular properties, the values are all that is needed (the
+    // table with regular properties only exists when there are declared or dynamic ones)
+    if (!object->properties && object->ce->default_properties_count == 0) return values;
+
+    // copy the regular properties, and add the values
+    HashTable *result = zend_array_dup(object->handlers->get_properties(object));
+    zend_hash_merge(result, values, zval_add_ref, 1);
+
+    // the values are no longer needed
+    zend_release_properties(values);
+
+    // done
+    return result;
 }
+#endif
 
 /**
  *  Function that is called when an object is about to be destructed
@@ -1251,6 +1715,35 @@ zend_object *ClassImpl::createObject(zend_class_entry *entry)
     // we need the C++ class meta-information object
     ClassImpl *impl = self(entry);
 
+    // the handlers for the object
+    auto *handlers = impl->objectHandlers();
+
+    // for the compact layout, everything is created in a single allocation
+    if (impl->_compact)
+    {
+        // create the object, and the C++ object inside it
+        auto *object = ObjectImpl::create(entry, impl->_base, handlers);
+
+        // report error on failure
+        if (!object) zend_error(E_ERROR, "Unable to instantiate %s", entry->name->val);
+
+        // return the php object stored in the implementation
+        return object->php();
+    }
+
+    // for classes with a pool, the C++ object is created in memory from the pool
+    if (impl->_pool)
+    {
+        // create the object, and the C++ object
+        auto *object = ObjectImpl::create(entry, impl->_base, handlers, impl->_pool.get());
+
+        // report error on failure
+        if (!object) zend_error(E_ERROR, "Unable to instantiate %s", entry->name->val);
+
+        // return the php object stored in the implementation
+        return object->php();
+    }
+
     // create a new base C++ object
     auto *cpp = impl->_base->construct();
 
@@ -1260,7 +1753,7 @@ zend_object *ClassImpl::createObject(zend_class_entry *entry)
     if (!cpp) zend_error(E_ERROR, "Unable to instantiate %s", entry->name->val);
 
     // create the object in the zend engine
-    auto *object = new ObjectImpl(entry, cpp, impl->objectHandlers(), 1);
+    auto *object = new ObjectImpl(entry, cpp, handlers, 1);
 
     // return the php object stored in the implementation
     return object->php();
@@ -1440,10 +1933,29 @@ int ClassImpl::unserialize(zval *object, zend_class_entry *entry, const unsigned
  */
 bool ClassImpl::hasMethod(const char* name) const
 {
-    // find the method
-    auto result = std::find_if(_methods.begin(), _methods.end(), [name](std::shared_ptr<Method> method){ return method->name() == name; });
-    // return wether its found or not
-    return result != _methods.end();
+    // method names are case insensitive
+    std::string key(name);
+    zend_str_tolower(&key[0], key.size());
+
+    // look up the method
+    return _methodIndex.find(key) != _methodIndex.end();
+}
+
+/**
+ *  Helper method to register a method
+ *  @param  method
+ */
+void ClassImpl::add(std::shared_ptr<Method> &&method)
+{
+    // method names are case insensitive
+    std::string key(method->name());
+    zend_str_tolower(&key[0], key.size());
+
+    // remember the name of the method
+    _methodIndex.insert(std::move(key));
+
+    // store the method
+    _methods.push_back(std::move(method));
 }
 
 /**
@@ -1574,8 +2086,8 @@ zend_class_entry *ClassImpl::initialize(ClassBase *base, const std::string &pref
     // when the create_object property is set for an interface)
     if (_type != ClassType::Interface) entry.create_object = &ClassImpl::createObject;
 
-    // register function that is called for static method calls
-    entry.get_static_method = &ClassImpl::getStaticMethod;
+    // register function that is called for static method calls (only needed for __callStatic)
+    if (_base->magic() & ClassBase::MagicCallStatic) entry.get_static_method = &ClassImpl::getStaticMethod;
 
     // for traversable classes we install a special method to get the iterator
     if (_base->traversable())
@@ -1681,6 +2193,18 @@ zend_class_entry *ClassImpl::initialize(ClassBase *base, const std::string &pref
     // declare all member variables
     for (auto &member : _members) member->initialize(_entry);
 
+    // index the properties with callbacks by their interned name (interned
+    // strings are owned by the engine, so we do not have to release them)
+    for (auto &property : _properties)
+    {
+        // create the name, and turn it into an interned string
+        zend_string *name = zend_new_interned_string(zend_string_init(property.first.data(), property.first.size(), 1));
+
+        // store the property
+        _lookup[name] = property.second.get();
+        _exported.emplace_back(name, property.second.get());
+    }
+
     // done
     return _entry;
 }
@@ -31,6 +31,18 @@ namespace Php {
 class ClassImpl
 {
 private:
+    /**
+     *  Hash and equality functors for tables that are indexed by zend_string
+     */
+    struct StringHash
+    {
+        size_t operator()(zend_string *name) const { return ZSTR_HASH(name); }
+    };
+    struct StringEqual
+    {
+        bool operator()(zend_string *a, zend_string *b) const { return zend_string_equals(a, b); }
+    };
+
     /**
      *  Pointer to the actual Php::Class<X> that is created in the extension
      *  @var    ClassBase
@@ -62,16 +74,23 @@ private:
     zend_function_entry *_entries = nullptr;
 
     /**
-     *  All class methods
-     *  @var    std::list
+     *  All class methods, in the order in which they were registered
+     *  @var    std::vector
      */
-    std::list<std::shared_ptr<Method>> _methods;
+    std::vector<std::shared_ptr<Method>> _methods;
+
+    /**
+     *  Lowercase names of the methods in the _methods vector (method names
+     *  in PHP are case insensitive)
+     *  @var    std::unordered_set
+     */
+    std::unordered_set<std::string> _methodIndex;
 
     /**
      *  All class members (class properties)
-     *  @var    std::list
+     *  @var    std::vector
      */
-    std::list<std::shared_ptr<Member>> _members;
+    std::vector<std::shared_ptr<Member>> _members;
 
     /**
      *  Map of dynamically accessible properties
@@ -79,11 +98,25 @@ private:
      */
     std::map<std::string,std::shared_ptr<Property>> _properties;
 
+    /**
+     *  The same properties, indexed by their interned name, so that the
+     *  property handlers do not have to construct a std::string to find
+     *  them (this table is filled when the class is registered)
+     *  @var    std::unordered_map
+     */
+    std::unordered_map<zend_string*,Property*,StringHash,StringEqual> _lookup;
+
+    /**
+     *  The same properties in alphabetical order, to export them all at once
+     *  @var    std::vector
+     */
+    std::vector<std::pair<zend_string*,Property*>> _exported;
+
     /**
      *  Interfaces that are implemented
-     *  @var    std::list
+     *  @var    std::vector
      */
-    std::list<std::shared_ptr<ClassImpl>> _interfaces;
+    std::vector<std::shared_ptr<ClassImpl>> _interfaces;
 
     /**
      *  The parent/base class
@@ -103,6 +136,42 @@ private:
      */
     bool _initialized = false;
 
+    /**
+     *  Are the C++ objects stored in the same block of memory as the zend objects?
+     *  @var    bool
+     */
+    bool _compact = false;
+
+    /**
+     *  Are the declared properties of the objects initialized on first access?
+     *  @var    bool
+     */
+    bool _lazy = false;
+
+    /**
+     *  Do the objects remember the values of the properties with callbacks?
+     *  @var    bool
+     */
+    bool _snapshot = false;
+
+    /**
+     *  Does the C++ class have a __clone() method?
+     *  @var    bool
+     */
+    bool _clone = false;
+
+    /**
+     *  Number of objects per slab for the pool (zero if no pool is used)
+     *  @var    size_t
+     */
+    size_t _slab = 0;
+
+    /**
+     *  The pool with memory for the C++ objects
+     *  @var    std::unique_ptr<ObjectPool>
+     */
+    std::unique_ptr<ObjectPool> _pool;
+
     /**
      *  Memory allocated by this object to hide a pointer
      *  @var    zend_string*
@@ -125,6 +194,24 @@ private:
      */
     bool hasMethod(const char* name) const;
 
+    /**
+     *  Helper method to register a method
+     *  @param  method
+     */
+    void add(std::shared_ptr<Method> &&method);
+
+    /**
+     *  Helper method to find a property with a getter and setter. The runtime
+     *  cache slot that zend passes to the property handlers is used to
+     *  remember the result, so that the lookup is done only once per opline
+     *
+     *  @param  entry       Class entry of the object
+     *  @param  name        Name of the property
+     *  @param  cache_slot  Runtime cache slot (can be nullptr)
+     *  @return Property    The property, or nullptr if it does not exist
+     */
+    Property *lookup(zend_class_entry *entry, ZEND_STRING_OR_ZVAL name, void **cache_slot) const;
+
     /**
      *  Helper method to turn a property into a zval
      *
@@ -140,8 +227,13 @@ public:
      *  Constructor
      *  @param  name            Class name
      *  @param  type            Class type
+     *  @param  options         Class options (Php::Compact, Php::LazyProperties and/or Php::SnapshotProperties)
      */
-    ClassImpl(const char *name, ClassType type) : _name(name), _type(type) {}
+    ClassImpl(const char *name, ClassType type, int options = 0) :
+        _name(name), _type(type),
+        _compact(options & Compact),
+        _lazy(options & LazyProperties),
+        _snapshot(options & SnapshotProperties) {}
 
     /**
      *  No copying or moving
@@ -238,6 +330,28 @@ public:
     static int  hasDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, int check_empty);
     static void unsetDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset);
 
+    /**
+     *  Alternative handlers for classes derived from TypedArrayBase, these
+     *  access the elements directly, without converting them to Php::Value
+     *  @param  object          The object on which it is called
+     *  @param  offset          The index
+     *  @param  value           The new value
+     *  @param  type            The type of the variable
+     *  @param  rv              Pointer to where to store the data
+     *  @param  check_empty     Was this an isset() call, or an empty() call?
+     *  @param  count           Pointer to where to store the number of elements
+     *  @return zval|int
+     */
+    static zval *readTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, int type, zval *rv);
+    static void writeTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, zval *value);
+    static int  hasTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset, int check_empty);
+    static void unsetTypedDimension(ZEND_OBJECT_OR_ZVAL object, zval *offset);
+#if PHP_VERSION_ID < 80200
+    static int countTypedElements(ZEND_OBJECT_OR_ZVAL object, zend_long *count);
+#else
+    static zend_result countTypedElements(ZEND_OBJECT_OR_ZVAL object, zend_long *count);
+#endif
+
     /**
      *  Retrieve pointer to our own object handlers
      *  @return zend_object_handlers
@@ -251,6 +365,36 @@ public:
      */
     static zend_object_handlers *objectHandlers(zend_class_entry *entry);
 
+    /**
+     *  Do objects with these handlers initialize their properties on first access?
+     *  @param  handlers
+     *  @return bool
+     */
+    static bool lazy(const zend_object_handlers *handlers) { return handlers->get_properties == &ClassImpl::getProperties; }
+
+    /**
+     *  Functions that are installed for classes with lazy properties, these
+     *  initialize the properties before they forward to the default handlers
+     *  @param  object          The object on which it is called
+     *  @param  name            The name of the property
+     *  @param  type            The type of access
+     *  @param  cache_slot      The cache slot used
+     *  @return HashTable|zval
+     */
+    static HashTable *getProperties(ZEND_OBJECT_OR_ZVAL object);
+    static zval *getPropertyPointer(ZEND_OBJECT_OR_ZVAL object, ZEND_STRING_OR_ZVAL name, int type, void **cache_slot);
+
+#if PHP_VERSION_ID >= 70400
+    /**
+     *  Function that is called to export the object (var_dump, json_encode,
+     *  array cast), this adds the properties with callbacks
+     *  @param  object          The object to export
+     *  @param  purpose         Why is it exported?
+     *  @return HashTable
+     */
+    static HashTable *getPropertiesFor(zend_object *object, zend_prop_purpose purpose);
+#endif
+
     /**
      *  Function to create a new iterator to iterate over an object
      *  @param  entry                   The class entry
@@ -387,7 +531,7 @@ public:
      *  @param  flags       Optional flags
      *  @param  args        Description of the supported arguments
      */
-    void method(const char *name, ZendCallback callback, int flags = 0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, callback, flags & MethodModifiers, args)); }
+    void method(const char *name, ZendCallback callback, int flags = 0, const Arguments &args = {}) { add(std::make_shared<Method>(name, callback, flags & MethodModifiers, args)); }
 
     /**
      *  Add a method to the class
@@ -404,14 +548,14 @@ public:
      *  @param  flags       Optional flags
      *  @param  args        Description of the supported arguments
      */
-    void method(const char *name, const method_callback_0 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_1 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_2 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_3 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_4 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_5 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_6 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
-    void method(const char *name, const method_callback_7 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_0 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_1 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_2 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_3 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_4 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_5 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_6 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
+    void method(const char *name, const method_callback_7 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, flags & MethodModifiers, args)); }
 
     /**
      *  Add a static method to the class
@@ -425,10 +569,10 @@ public:
      *  @param  flags       Optional flags
      *  @param  args        Description of the supported arguments
      */
-    void method(const char *name, const native_callback_0 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
-    void method(const char *name, const native_callback_1 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
-    void method(const char *name, const native_callback_2 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
-    void method(const char *name, const native_callback_3 &method, int flags=0, const Arguments &args = {}) { _methods.push_back(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
+    void method(const char *name, const native_callback_0 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
+    void method(const char *name, const native_callback_1 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
+    void method(const char *name, const native_callback_2 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
+    void method(const char *name, const native_callback_3 &method, int flags=0, const Arguments &args = {}) { add(std::make_shared<Method>(name, method, (flags & MethodModifiers) | Static, args)); }
 
     /**
      *  Add an abstract method to the class
@@ -444,7 +588,7 @@ public:
         // expect that we could even force adding "Abstract" here, because we're adding an abstract method -- but
         // in a PHP interface the "Abstract" modifier is not allowed - even though it is of course abstract.
         // So we only _allow_ abstract here, and expect the caller to _set_ it.
-        _methods.push_back(std::make_shared<Method>(name, (flags & (MethodModifiers | Static | Abstract)), args));
+        add(std::make_shared<Method>(name, (flags & (MethodModifiers | Static | Abstract)), args));
     }
 
     /**
@@ -495,6 +639,18 @@ public:
      */
     void extends(const std::shared_ptr<ClassImpl> &base) { _parent = base; }
 
+    /**
+     *  Keep the memory of the C++ objects in a pool
+     *  @param  count       Number of objects per slab
+     */
+    void pool(size_t count) { _slab = count; }
+
+    /**
+     *  Statistics about the pool
+     *  @return PoolStatistics
+     */
+    PoolStatistics statistics() const { return _pool ? _pool->statistics() : PoolStatistics(); }
+
 };
 
 /**
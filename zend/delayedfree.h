@@ -4,7 +4,9 @@
  *  Sometimes a piece of data must be freed when a function gets out of
  *  scope. In stead of putting the efree() call right before every possible
  *  function end point (exceptions, returns, zend_errors()), we can use
- *  this simple class instead
+ *  this simple class instead. It also knows how to release the trampoline
+ *  function of the executor globals, which is not freed but made available
+ *  for the next call.
  *
  *  @author Emiel Bruijntjes <emiel.bruijntjes@copernica.com>
  *  @copyright 2015 Copernica BV
@@ -39,8 +41,8 @@ public:
      */
     virtual ~DelayedFree()
     {
-        // free the data
-        efree(_data);
+        // free the data (or release the trampoline, zend_free_trampoline() falls back to efree())
+        zend_free_trampoline((zend_function *)_data);
     }
 };
 
@@ -92,8 +92,8 @@ Value error_reporting(Message message)
     // if we failed for some reason we bail out
     if (size < 0) return false;
 
-    // the entry to change - static to avoid unnecessary extra allocations
-    static String entry{ "error_reporting" };
+    // the entry to change (this is allocated from the request memory, so it can not be static)
+    String entry{ "error_reporting" };
 
     // alter the ini on the fly
     zend_alter_ini_entry_chars(entry, str, size, ZEND_INI_USER, ZEND_INI_STAGE_RUNTIME);
@@ -177,6 +177,20 @@ ZEND_RESULT_OR_INT ExtensionImpl::processIdle(int type, int module_number)
     return SUCCESS;
 }
 
+/**
+ *  Function that is called after the request has ended, and all objects
+ *  have been destructed
+ *  @return int         0 on success
+ */
+ZEND_RESULT_OR_INT ExtensionImpl::processRecycle()
+{
+    // the memory in the object pools is no longer in use
+    ObjectPool::recycleAll();
+
+    // done
+    return SUCCESS;
+}
+
 /**
  *  Function that is called when the PHP engine initializes with a different PHP-CPP
  *  version for the libphpcpp.so file than the version the extension was compiled for
@@ -227,7 +241,7 @@ ExtensionImpl::ExtensionImpl(Extension *data, const char *name, const char *vers
     _entry.globals_size = 0;                                       // size of the global variables
     _entry.globals_ctor = NULL;                                    // constructor for global variables
     _entry.globals_dtor = NULL;                                    // destructor for global variables
-    _entry.post_deactivate_func = NULL;                            // unknown function
+    _entry.post_deactivate_func = &ExtensionImpl::processRecycle;  // called after all objects of the request were destructed
     _entry.module_started = 0;                                     // module is not yet started
     _entry.type = 0;                                               // temporary or persistent module, will be filled by Zend engine
     _entry.handle = NULL;                                          // dlopen() handle, will be filled by Zend engine
@@ -252,6 +266,7 @@ ExtensionImpl::ExtensionImpl(Extension *data, const char *name, const char *vers
     _entry.module_shutdown_func = nullptr;
     _entry.request_startup_func = nullptr;
     _entry.request_shutdown_func = nullptr;
+    _entry.post_deactivate_func = nullptr;
 }
 
 /**
@@ -189,6 +189,13 @@ private:
      */
     static ZEND_RESULT_OR_INT processIdle(int type, int module_number);
 
+    /**
+     *  Function that is called after the request has ended, and all objects
+     *  have been destructed
+     *  @return int         0 on success
+     */
+    static ZEND_RESULT_OR_INT processRecycle();
+
     /**
      *  Function that is called when the PHP engine initializes with a different PHP-CPP
      *  version for the libphpcpp.so file than the version the extension was compiled for
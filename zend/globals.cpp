@@ -7,7 +7,6 @@
  *  @copyright 2013 Copernica BV
  */
 #include "includes.h"
-#include "string.h"
 
 /**
  *  Namespace
@@ -38,7 +37,7 @@ Globals &GLOBALS = Globals::instance();
 Global Globals::operator[](const char *name)
 {
     // retrieve the variable (if it exists)
-    zval *varvalue = zend_hash_find_ind(&EG(symbol_table), String{ name });
+    zval *varvalue = zend_hash_str_find_ind(&EG(symbol_table), name, ::strlen(name));
 
     // check if the variable already exists
     if (!varvalue)
@@ -63,7 +62,7 @@ Global Globals::operator[](const char *name)
 Global Globals::operator[](const std::string &name)
 {
     // retrieve the variable (if it exists)
-    auto *varvalue = zend_hash_find_ind(&EG(symbol_table), String{ name.data(), name.size() });
+    auto *varvalue = zend_hash_str_find_ind(&EG(symbol_table), name.data(), name.size());
 
     // check if the variable already exists
     if (!varvalue)
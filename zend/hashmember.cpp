@@ -33,6 +33,17 @@ std::ostream &operator<<(std::ostream &stream, const HashMember<std::string> &va
     return stream << value.value();
 }
 
+/**
+ *  Custom output stream operator
+ *  @param  stream
+ *  @param  value
+ *  @return ostream
+ */
+std::ostream &operator<<(std::ostream &stream, const HashMember<Key> &value)
+{
+    return stream << value.value();
+}
+
 /**
  *  End of namespace
  */
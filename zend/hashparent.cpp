@@ -0,0 +1,264 @@
+/**
+ *  HashParent.cpp
+ *
+ *  Helper methods for looking up and writing array elements in place
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Helper function to check whether the hash values that are calculated by
+ *  Php::Key are the same as the ones that are calculated by the Zend engine
+ *  (if not, which should never happen, we fall back to regular lookups)
+ *  @return bool
+ */
+static bool compatible()
+{
+    // a key for testing
+    static const Key key("PHP-CPP");
+
+    // compare the hash values only once
+    static const bool result = key.hash() == zend_hash_func(key.data(), key.size());
+
+    // done
+    return result;
+}
+
+/**
+ *  Helper function to create a zend_string for a key, with the hash value
+ *  already filled in
+ *  @param  key
+ *  @return zend_string
+ */
+static zend_string *string(const Key &key)
+{
+    // create the string
+    zend_string *result = zend_string_init(key.data(), key.size(), 0);
+
+    // the hash table does not have to calculate the hash any more
+    if (compatible()) ZSTR_H(result) = key.hash();
+
+    // done
+    return result;
+}
+
+/**
+ *  Helper function to make an element of an array writable
+ *  @param  element
+ *  @return zval
+ */
+static zval *prepare(zval *element)
+{
+    // we write to the variable that the element refers to
+    ZVAL_DEREF(element);
+
+    // objects are not written in place
+    if (Z_TYPE_P(element) == IS_OBJECT) return nullptr;
+
+    // turn the element into an array, or separate it from other copies
+    if (Z_TYPE_P(element) != IS_ARRAY) convert_to_array(element);
+    else SEPARATE_ARRAY(element);
+
+    // done
+    return element;
+}
+
+/**
+ *  Helper function to find or add an element with a numeric key
+ *  @param  table
+ *  @param  index
+ *  @return zval
+ */
+static zval *lookup(HashTable *table, zend_ulong index)
+{
+    // check if the element already exists
+    zval *result = zend_hash_index_find(table, index);
+    if (result) return result;
+
+    // add a null value
+    zval null;
+    ZVAL_NULL(&null);
+    return zend_hash_index_add_new(table, index, &null);
+}
+
+/**
+ *  Find an element by a key with a precalculated hash
+ *  @param  table
+ *  @param  key
+ *  @return zval
+ */
+zval *HashParent::find(HashTable *table, const Key &key)
+{
+    // numeric strings are stored as numeric keys (the same way as they are written)
+    zend_ulong numeric;
+    if (ZEND_HANDLE_NUMERIC_STR(key.data(), key.size(), numeric)) return zend_hash_index_find(table, numeric);
+
+    // if the hash values are not compatible, the hash table has to hash the key
+    if (!compatible()) return zend_hash_str_find(table, key.data(), key.size());
+
+    // packed and uninitialized tables have no string keys
+#if PHP_VERSION_ID >= 70300
+    if (HT_FLAGS(table) & (HASH_FLAG_PACKED | HASH_FLAG_UNINITIALIZED)) return nullptr;
+#else
+    if ((table->u.flags & HASH_FLAG_PACKED) || !(table->u.flags & HASH_FLAG_INITIALIZED)) return nullptr;
+#endif
+
+    // the hash value
+    zend_ulong hash = key.hash();
+
+    // walk the collision chain of the slot (the same way as the Zend engine does)
+    uint32_t index = HT_HASH(table, hash | table->nTableMask);
+    while (index != HT_INVALID_IDX)
+    {
+        // the bucket at this position
+        Bucket *bucket = HT_HASH_TO_BUCKET(table, index);
+
+        // compare the hash first, then the string itself
+        if (bucket->h == hash && bucket->key && ZSTR_LEN(bucket->key) == key.size() && memcmp(ZSTR_VAL(bucket->key), key.data(), key.size()) == 0) return &bucket->val;
+
+        // move on to the next bucket in the chain
+        index = Z_NEXT(bucket->val);
+    }
+
+    // not found
+    return nullptr;
+}
+
+/**
+ *  Find or add an element with a numeric index, and make it writable
+ *  @param  array
+ *  @param  index
+ *  @return zval
+ */
+zval *HashParent::element(zval *array, int index)
+{
+    return prepare(lookup(Z_ARRVAL_P(array), index));
+}
+
+/**
+ *  Find or add an element with a string key, and make it writable
+ *  @param  array
+ *  @param  key
+ *  @return zval
+ */
+zval *HashParent::element(zval *array, const Key &key)
+{
+    // the hash table
+    HashTable *table = Z_ARRVAL_P(array);
+
+    // numeric strings are stored as numeric keys
+    zend_ulong index;
+    if (ZEND_HANDLE_NUMERIC_STR(key.data(), key.size(), index)) return prepare(lookup(table, index));
+
+    // check if the element already exists
+    zval *result = find(table, key);
+    if (result) return prepare(result);
+
+    // add a null value
+    zval null;
+    ZVAL_NULL(&null);
+    zend_string *str = string(key);
+    result = zend_hash_add_new(table, str, &null);
+    zend_string_release(str);
+
+    // done
+    return prepare(result);
+}
+
+/**
+ *  Find or add an element with a variant key, and make it writable
+ *  @param  array
+ *  @param  key
+ *  @return zval
+ */
+zval *HashParent::element(zval *array, const Value &key)
+{
+    // use the same conversions as Value::set()
+    if (key.isNumeric()) return prepare(lookup(Z_ARRVAL_P(array), key.numericValue()));
+    if (key.isString()) return element(array, Key(key.rawValue(), key.size()));
+
+    // convert the key into a string
+    std::string str(key.stringValue());
+    return element(array, Key(str.data(), str.size()));
+}
+
+/**
+ *  Store an element with a numeric index
+ *  @param  array
+ *  @param  index
+ *  @param  value
+ */
+void HashParent::update(zval *array, int index, const Value &value)
+{
+    // the variable gets one more reference (the array entry)
+    Z_TRY_ADDREF_P(value._val);
+
+    // add the value (this will decrement refcount on any current variable)
+    zend_hash_index_update(Z_ARRVAL_P(array), index, value._val);
+}
+
+/**
+ *  Store an element with a string key
+ *  @param  array
+ *  @param  key
+ *  @param  value
+ */
+void HashParent::update(zval *array, const Key &key, const Value &value)
+{
+    // the hash table
+    HashTable *table = Z_ARRVAL_P(array);
+
+    // the variable gets one more reference (the array entry)
+    Z_TRY_ADDREF_P(value._val);
+
+    // numeric strings are stored as numeric keys
+    zend_ulong index;
+    if (ZEND_HANDLE_NUMERIC_STR(key.data(), key.size(), index))
+    {
+        // add the value (this will decrement refcount on any current variable)
+        zend_hash_index_update(table, index, value._val);
+    }
+    else if (zval *current = find(table, key))
+    {
+        // replace the current value, and release the old one
+        zval old;
+        ZVAL_COPY_VALUE(&old, current);
+        ZVAL_COPY_VALUE(current, value._val);
+        zval_ptr_dtor(&old);
+    }
+    else
+    {
+        // add a new element, the hash table keeps its own reference to the key
+        zend_string *str = string(key);
+        zend_hash_add_new(table, str, value._val);
+        zend_string_release(str);
+    }
+}
+
+/**
+ *  Store an element with a variant key
+ *  @param  array
+ *  @param  key
+ *  @param  value
+ */
+void HashParent::update(zval *array, const Value &key, const Value &value)
+{
+    // use the same conversions as Value::set()
+    if (key.isNumeric()) return update(array, key.numericValue(), value);
+    if (key.isString()) return update(array, Key(key.rawValue(), key.size()), value);
+
+    // convert the key into a string
+    std::string str(key.stringValue());
+    update(array, Key(str.data(), str.size()), value);
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,221 @@
+/**
+ *  HashView.cpp
+ *
+ *  Implementation of the non-owning view on the elements of an array
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+#include "numericstring.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Move to the first valid element at or after the current position
+ */
+void HashView::iterator::seek()
+{
+    // leap out if there is no table
+    if (!_table) return;
+
+#if PHP_VERSION_ID >= 80200
+    // since php 8.2 packed arrays store plain zvals without keys
+    if (HT_IS_PACKED(_table))
+    {
+        // skip the holes
+        while (_position < _table->nNumUsed && Z_ISUNDEF(_table->arPacked[_position])) _position += 1;
+
+        // leap out if at the end
+        if (_position >= _table->nNumUsed) return;
+
+        // the key is the position itself
+        _zval = &_table->arPacked[_position];
+        _string = nullptr;
+        _index = _position;
+    }
+    else
+#endif
+    {
+        // skip the holes
+        while (_position < _table->nNumUsed && Z_ISUNDEF(_table->arData[_position].val)) _position += 1;
+
+        // leap out if at the end
+        if (_position >= _table->nNumUsed) return;
+
+        // read the bucket
+        Bucket *bucket = &_table->arData[_position];
+        _zval = &bucket->val;
+        _string = bucket->key;
+        _index = bucket->h;
+    }
+
+    // we never expose the reference itself
+    ZVAL_DEREF(_zval);
+}
+
+/**
+ *  Iterator to the position behind the last element
+ *  @return iterator
+ */
+HashView::iterator HashView::end() const
+{
+    return iterator(_table, _table ? _table->nNumUsed : 0);
+}
+
+/**
+ *  Number of elements
+ *  @return size_t
+ */
+size_t HashView::size() const
+{
+    return _table ? zend_hash_num_elements(_table) : 0;
+}
+
+/**
+ *  Is the array a list?
+ *  @return bool
+ */
+bool HashView::isList() const
+{
+    // there must be a table
+    if (!_table) return false;
+
+#if defined(HT_IS_PACKED) && defined(HT_IS_WITHOUT_HOLES)
+    // packed tables without holes are stored in key order, starting at 0
+    return HT_IS_PACKED(_table) && HT_IS_WITHOUT_HOLES(_table);
+#else
+    // older php versions
+    return (_table->u.flags & HASH_FLAG_PACKED) && _table->nNumUsed == _table->nNumOfElements;
+#endif
+}
+
+/**
+ *  Direct access to the buffer of a string key
+ *  @return const char *
+ */
+const char *KeyView::rawValue() const
+{
+    return _string ? ZSTR_VAL(_string) : nullptr;
+}
+
+/**
+ *  Size of a string key
+ *  @return size_t
+ */
+size_t KeyView::size() const
+{
+    return _string ? ZSTR_LEN(_string) : 0;
+}
+
+/**
+ *  The key as string
+ *  @return std::string
+ */
+std::string KeyView::stringValue() const
+{
+    return _string ? std::string(ZSTR_VAL(_string), ZSTR_LEN(_string)) : std::to_string(_index);
+}
+
+/**
+ *  Create a Php::Value object holding the key
+ *  @return Value
+ */
+Value KeyView::value() const
+{
+    return _string ? Value(_string) : Value(_index);
+}
+
+/**
+ *  The type of the value
+ *  @return Type
+ */
+Type ValueView::type() const
+{
+    return (Type)Z_TYPE_P(_zval);
+}
+
+/**
+ *  Retrieve the value as integer
+ *  @return int64_t
+ */
+int64_t ValueView::numericValue() const
+{
+    // convert to an integer (with a shortcut for plain integer strings)
+    return NumericString::toLong(_zval);
+}
+
+/**
+ *  Retrieve the value as boolean
+ *  @return bool
+ */
+bool ValueView::boolValue() const
+{
+    // apply the regular php rules
+    return zend_is_true(_zval);
+}
+
+/**
+ *  Retrieve the value as floating point number
+ *  @return double
+ */
+double ValueView::floatValue() const
+{
+    // convert to a floating point number (with a shortcut for plain integer strings)
+    return NumericString::toDouble(_zval);
+}
+
+/**
+ *  Retrieve the value as string
+ *  @return std::string
+ */
+std::string ValueView::stringValue() const
+{
+    // strings can be copied right away
+    if (Z_TYPE_P(_zval) == IS_STRING) return std::string(Z_STRVAL_P(_zval), Z_STRLEN_P(_zval));
+
+    // convert to a string first
+    zend_string *str = zval_get_string(_zval);
+    std::string result(ZSTR_VAL(str), ZSTR_LEN(str));
+    zend_string_release(str);
+
+    // done
+    return result;
+}
+
+/**
+ *  Direct access to the buffer of a string value
+ *  @return const char *
+ */
+const char *ValueView::rawValue() const
+{
+    return Z_TYPE_P(_zval) == IS_STRING ? Z_STRVAL_P(_zval) : nullptr;
+}
+
+/**
+ *  Size of a string value
+ *  @return size_t
+ */
+size_t ValueView::size() const
+{
+    return Z_TYPE_P(_zval) == IS_STRING ? Z_STRLEN_P(_zval) : 0;
+}
+
+/**
+ *  Create a Php::Value object holding the value
+ *  @return Value
+ */
+Value ValueView::value() const
+{
+    // the value is shared, not copied
+    Value result;
+    ZVAL_COPY(result._val, _zval);
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
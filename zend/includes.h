@@ -20,12 +20,22 @@
 #include <initializer_list>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <set>
 #include <memory>
 #include <list>
 #include <exception>
 #include <type_traits>
 #include <functional>
+#include <atomic>
+#include <algorithm>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 // for debug
 #include <iostream>
@@ -73,10 +83,13 @@
 #include "../include/streams.h"
 #include "../include/type.h"
 #include "../include/message.h"
+#include "../include/key.h"
 #include "../include/hashparent.h"
+#include "../include/hashview.h"
 #include "../include/value.h"
 #include "../include/valueiterator.h"
 #include "../include/array.h"
+#include "../include/arraybuilder.h"
 #include "../include/object.h"
 #include "../include/globals.h"
 #include "../include/argument.h"
@@ -86,6 +99,7 @@
 #include "../include/hashmember.h"
 #include "../include/super.h"
 #include "../include/parameters.h"
+#include "../include/parameterview.h"
 #include "../include/modifiers.h"
 #include "../include/base.h"
 #include "../include/countable.h"
@@ -93,15 +107,20 @@
 #include "../include/serializable.h"
 #include "../include/iterator.h"
 #include "../include/traversable.h"
+#include "../include/typedarraybase.h"
 #include "../include/classtype.h"
+#include "../include/poolstatistics.h"
 #include "../include/classbase.h"
 #include "../include/interface.h"
 #include "../include/constant.h"
 #include "../include/zendcallable.h"
+#include "../include/signature.h"
 #include "../include/class.h"
+#include "../include/typedarray.h"
 #include "../include/namespace.h"
 #include "../include/extension.h"
 #include "../include/call.h"
+#include "../include/callablehandle.h"
 #include "../include/script.h"
 #include "../include/file.h"
 #include "../include/function.h"
@@ -135,6 +154,7 @@
 #include "invaliditerator.h"
 #include "traverseiterator.h"
 #include "iteratorimpl.h"
+#include "objectpool.h"
 #include "classimpl.h"
 #include "objectimpl.h"
 #include "parametersimpl.h"
@@ -0,0 +1,134 @@
+/**
+ *  NumericString.h
+ *
+ *  Fast parser for strings that hold a plain decimal integer, which is by
+ *  far the most common type of numeric string that is passed to an
+ *  extension (think of ids from query strings and database results). Eight
+ *  digits are validated and combined at once with a couple of 64 bit
+ *  operations. Everything else (whitespace, fractions, exponents, hex, very
+ *  large numbers) is left to the regular conversion of the Zend engine.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Include guard
+ */
+#pragma once
+
+/**
+ *  Begin of namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class NumericString
+{
+private:
+    /**
+     *  Parse a block of eight digits
+     *  @param  data        Pointer to the first digit
+     *  @param  result      Output parameter for the value of the block
+     *  @return bool        Were all eight characters digits?
+     */
+    static bool block(const char *data, uint64_t &result)
+    {
+        // load the eight characters (the first one ends up in the lowest byte)
+        uint64_t chunk;
+        memcpy(&chunk, data, 8);
+
+        // all high nibbles must be 3, and adding 6 to the low nibbles may not overflow them
+        if ((chunk & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030) return false;
+        if (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) != 0x3030303030303030) return false;
+
+        // the values of the digits
+        chunk -= 0x3030303030303030;
+
+        // combine them into pairs, groups of four, and then into one number
+        chunk = ((chunk * 10) + (chunk >> 8)) & 0x00FF00FF00FF00FF;
+        chunk = ((chunk * 100) + (chunk >> 16)) & 0x0000FFFF0000FFFF;
+        result = ((chunk * 10000) + (chunk >> 32)) & 0x00000000FFFFFFFF;
+
+        // done
+        return true;
+    }
+
+public:
+    /**
+     *  Parse a string that holds an optional sign followed by at most 18
+     *  digits (so that the value always fits in 64 bits)
+     *  @param  data        The string
+     *  @param  size        Size of the string
+     *  @param  result      Output parameter for the value
+     *  @return bool        Was the string in this format?
+     */
+    static bool parse(const char *data, size_t size, int64_t &result)
+    {
+        // optional sign
+        bool negative = size > 0 && data[0] == '-';
+        if (size > 0 && (data[0] == '-' || data[0] == '+')) { data += 1; size -= 1; }
+
+        // there must be digits, but not too many
+        if (size == 0 || size > 18) return false;
+
+        // the value so far
+        uint64_t value = 0;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // process blocks of eight digits
+        for (uint64_t chunk; size >= 8; data += 8, size -= 8)
+        {
+            if (!block(data, chunk)) return false;
+            value = value * 100000000 + chunk;
+        }
+#endif
+
+        // process the remaining digits one by one
+        for (; size > 0; data += 1, size -= 1)
+        {
+            unsigned digit = (unsigned char)*data - '0';
+            if (digit > 9) return false;
+            value = value * 10 + digit;
+        }
+
+        // done
+        result = negative ? -(int64_t)value : (int64_t)value;
+        return true;
+    }
+
+    /**
+     *  Convert a zval to an integer. Integers need no conversion and most
+     *  numeric strings are plain integers, other types use the regular
+     *  conversion of the Zend engine.
+     *  @param  value
+     *  @return int64_t
+     */
+    static int64_t toLong(zval *value)
+    {
+        int64_t result;
+        if (Z_TYPE_P(value) == IS_LONG) return Z_LVAL_P(value);
+        if (Z_TYPE_P(value) == IS_STRING && parse(Z_STRVAL_P(value), Z_STRLEN_P(value), result)) return result;
+        return zval_get_long(value);
+    }
+
+    /**
+     *  Convert a zval to a floating point number, with the same shortcuts
+     *  @param  value
+     *  @return double
+     */
+    static double toDouble(zval *value)
+    {
+        int64_t result;
+        if (Z_TYPE_P(value) == IS_DOUBLE) return Z_DVAL_P(value);
+        if (Z_TYPE_P(value) == IS_LONG) return (double)Z_LVAL_P(value);
+        if (Z_TYPE_P(value) == IS_STRING && parse(Z_STRVAL_P(value), Z_STRLEN_P(value), result)) return (double)result;
+        return zval_get_double(value);
+    }
+};
+
+/**
+ *  End of namespace
+ */
+}
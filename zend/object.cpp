@@ -119,11 +119,8 @@ bool Object::instantiate(const char *name)
     // @todo    is this a memory leak? the base class first initializes a stdClass,
     //          and then we overwrite it with a specific class
 
-    // initialize the string for __construct only once
-    static String construct{ "__construct" };
-
-    // return whether there is a __construct function
-    return zend_hash_exists(&entry->function_table, construct);
+    // return whether there is a __construct function (the lookup does not need a zend_string)
+    return zend_hash_str_exists(&entry->function_table, "__construct", sizeof("__construct") - 1);
 }
 
 /**
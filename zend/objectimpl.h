@@ -47,30 +47,111 @@ private:
      */
     std::unique_ptr<Base> _object;
 
-public:
     /**
-     *  Constructor
-     *
-     *  This will create a new object in the Zend engine.
-     *
+     *  Are we (and the C++ object) stored in the same block of memory as the zend_object?
+     *  @var    bool
+     */
+    bool _compact = false;
+
+    /**
+     *  The pool from which the memory for us (and the C++ object) was allocated
+     *  @var    ObjectPool
+     */
+    ObjectPool *_pool = nullptr;
+
+    /**
+     *  Have the declared properties been initialized? (objects of classes
+     *  with lazy properties do this on first access)
+     *  @var    bool
+     */
+    bool _materialized = true;
+
+    /**
+     *  Snapshot of the values of the properties with callbacks (only for
+     *  classes with the Php::SnapshotProperties option)
+     *  @var    HashTable
+     */
+    HashTable *_snapshot = nullptr;
+
+    /**
+     *  Round a size up to a multiple of the pointer size
+     *  @param  size
+     *  @return size_t
+     */
+    static constexpr size_t align(size_t size)
+    {
+        return (size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    }
+
+    /**
+     *  Allocate the memory for the zend_object. Zend deallocates this memory by
+     *  itself, starting at the offset that is set in the handlers, which leaves
+     *  room for the C++ object in front of it for classes with a compact layout.
      *  @param  entry       Zend class entry
-     *  @param  handler     Zend object handlers
-     *  @param  base        C++ object that already exists
-     *  @param  refcount    The initial refcount for the object
+     *  @param  handlers    Zend object handlers
+     *  @return char*       The start of the allocated memory
      */
-    ObjectImpl(zend_class_entry *entry, Base *base, zend_object_handlers *handlers, int refcount) :
-        _object(base)
+    static char *allocate(zend_class_entry *entry, zend_object_handlers *handlers)
+    {
+        return (char *)ecalloc(1, handlers->offset + sizeof(zend_object) + zend_object_properties_size(entry));
+    }
+
+    /**
+     *  Constructor for objects with a compact layout
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that was constructed in the same memory
+     *  @param  handlers    Zend object handlers
+     *  @param  memory      The start of the allocated memory
+     *  @param  properties  Initialize the declared properties?
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base, zend_object_handlers *handlers, char *memory, bool properties) :
+        _mixed((MixedObject *)(memory + handlers->offset - offset())),
+        _object(base),
+        _compact(true)
+    {
+        // initialize the object
+        initialize(entry, base, handlers, 1, properties);
+    }
+
+    /**
+     *  Constructor for objects that are allocated from a pool
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object that was constructed in memory from the pool
+     *  @param  handlers    Zend object handlers
+     *  @param  pool        The pool
+     *  @param  properties  Initialize the declared properties?
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base, zend_object_handlers *handlers, ObjectPool *pool, bool properties) :
+        _mixed((MixedObject *)(allocate(entry, handlers) + handlers->offset - offset())),
+        _object(base),
+        _pool(pool)
     {
-        // allocate a mixed object (for some reason this does not have to be deallocated)
-        _mixed = (MixedObject *)ecalloc(1, sizeof(MixedObject) + zend_object_properties_size(entry));
+        // initialize the object
+        initialize(entry, base, handlers, 1, properties);
+    }
 
+    /**
+     *  Initialize the mixed object
+     *  @param  entry       Zend class entry
+     *  @param  base        C++ object
+     *  @param  handlers    Zend object handlers
+     *  @param  refcount    The initial refcount for the object
+     *  @param  properties  Initialize the declared properties? (not for clones, they are copied)
+     */
+    void initialize(zend_class_entry *entry, Base *base, zend_object_handlers *handlers, int refcount, bool properties)
+    {
         // copy properties to the mixed object
         _mixed->php.ce = entry;
         _mixed->self = this;
 
-        // initialize the object and its properties
-        zend_object_std_init  (&_mixed->php, entry);
-        object_properties_init(&_mixed->php, entry);
+        // initialize the object
+        zend_object_std_init(&_mixed->php, entry);
+
+        // initialize the properties, unless this is postponed until they are
+        // accessed or they are copied later (the slots were zeroed by ecalloc(),
+        // so they are undefined)
+        if (!properties || ClassImpl::lazy(handlers)) _materialized = false;
+        else object_properties_init(&_mixed->php, entry);
 
         // install the handlers
         _mixed->php.handlers = handlers;
@@ -85,11 +166,100 @@ public:
         base->_impl = this;
     }
 
+public:
+    /**
+     *  Constructor
+     *
+     *  This will create a new object in the Zend engine.
+     *
+     *  @param  entry       Zend class entry
+     *  @param  handler     Zend object handlers
+     *  @param  base        C++ object that already exists
+     *  @param  refcount    The initial refcount for the object
+     *  @param  properties  Initialize the declared properties? (not for clones)
+     */
+    ObjectImpl(zend_class_entry *entry, Base *base, zend_object_handlers *handlers, int refcount, bool properties = true) :
+        _object(base)
+    {
+        // allocate a mixed object (this does not have to be deallocated, zend does that)
+        _mixed = (MixedObject *)(allocate(entry, handlers) + handlers->offset - offset());
+
+        // initialize the object
+        initialize(entry, base, handlers, refcount, properties);
+    }
+
+    /**
+     *  Create a new object with a compact layout: the C++ object, this
+     *  implementation object and the zend_object are all stored in one
+     *  single block of memory
+     *
+     *  @param  entry       Zend class entry
+     *  @param  meta        Meta information about the class
+     *  @param  handlers    Zend object handlers
+     *  @param  orig        Optional C++ object to copy (when an object is cloned)
+     *  @return ObjectImpl  The object, or nullptr if the C++ object could not be constructed
+     */
+    static ObjectImpl *create(zend_class_entry *entry, const ClassBase *meta, zend_object_handlers *handlers, Base *orig = nullptr)
+    {
+        // allocate all memory at once
+        char *memory = allocate(entry, handlers);
+
+        // construct (or copy) the C++ object at the start of the memory
+        Base *base = orig ? meta->clone(orig, memory) : meta->construct(memory);
+
+        // on failure the memory is no longer needed
+        if (!base) { efree(memory); return nullptr; }
+
+        // construct ourselves right after the C++ object
+        return new (memory + align(meta->size())) ObjectImpl(entry, base, handlers, memory, orig == nullptr);
+    }
+
+    /**
+     *  Create a new object of which the C++ object, and this implementation
+     *  object, are stored in memory from a pool (we come first, followed
+     *  by the C++ object)
+     *
+     *  @param  entry       Zend class entry
+     *  @param  meta        Meta information about the class
+     *  @param  handlers    Zend object handlers
+     *  @param  pool        The pool to allocate from
+     *  @param  orig        Optional C++ object to copy (when an object is cloned)
+     *  @return ObjectImpl  The object, or nullptr if the C++ object could not be constructed
+     */
+    static ObjectImpl *create(zend_class_entry *entry, const ClassBase *meta, zend_object_handlers *handlers, ObjectPool *pool, Base *orig = nullptr)
+    {
+        // allocate memory from the pool
+        char *memory = (char *)pool->allocate();
+
+        // construct (or copy) the C++ object after the space that we need ourselves
+        Base *base = orig ? meta->clone(orig, memory + align(sizeof(ObjectImpl))) : meta->construct(memory + align(sizeof(ObjectImpl)));
+
+        // on failure the memory goes back to the pool
+        if (!base) { pool->release(memory); return nullptr; }
+
+        // construct ourselves at the start of the memory
+        return new (memory) ObjectImpl(entry, base, handlers, pool, orig == nullptr);
+    }
+
+    /**
+     *  Number of bytes of pool memory that is needed for an object
+     *  @param  size        Size of the C++ object
+     *  @return size_t
+     */
+    static constexpr size_t size(size_t size)
+    {
+        return align(sizeof(ObjectImpl)) + align(size);
+    }
+
     /**
      *  Destructor
      */
     virtual ~ObjectImpl()
     {
+        // forget the snapshot
+        invalidate();
+
+        // destruct the zend object
         zend_object_std_dtor(&_mixed->php);
     }
 
@@ -98,8 +268,20 @@ public:
      */
     void destruct()
     {
-        // destruct the object
-        delete this;
+        // objects with a regular layout can simply be deleted
+        if (!_compact && !_pool) { delete this; return; }
+
+        // the C++ object and we ourselves live in memory that is owned by
+        // zend or by the pool, so we only call the destructors (the C++
+        // object is destructed last, just like it is in the destructor)
+        Base *base = _object.release();
+        ObjectPool *pool = _pool;
+        void *memory = this;
+        this->~ObjectImpl();
+        base->~Base();
+
+        // pool memory must be given back
+        if (pool) pool->release(memory);
     }
 
     /**
@@ -115,6 +297,20 @@ public:
         return offsetof(MixedObject, php);
     }
 
+    /**
+     *  The offset between the start of the allocated memory and the zend_object
+     *  for classes with a compact layout, in which case the C++ object and
+     *  the ObjectImpl are stored in front of the mixed object
+     *
+     *  @param  size        Size of the C++ object
+     *  @return The offset in bytes
+     */
+    static constexpr size_t offset(size_t size)
+    {
+        // calculate the offset in bytes
+        return align(size) + align(sizeof(ObjectImpl)) + offset();
+    }
+
     /**
      *  Find the object based on a zval
      *  @param  val         Zval object
@@ -143,6 +339,85 @@ public:
         return mixed->self;
     }
 
+    /**
+     *  Initialize the declared properties if that had not yet happened
+     */
+    void materialize()
+    {
+        // nothing to do if the properties are already there
+        if (_materialized) return;
+
+        // copy the default values to the property slots
+        object_properties_init(&_mixed->php, _mixed->php.ce);
+
+        // remember that this has happened
+        _materialized = true;
+    }
+
+    /**
+     *  Copy the properties from the object that is cloned (the declared
+     *  properties of this object must not have been initialized)
+     *  @param  orig        The original object
+     */
+    void clone(const ObjectImpl *orig)
+    {
+        // copy the properties (this also calls a __clone() method that is visible to PHP)
+        zend_objects_clone_members(&_mixed->php, orig->php());
+
+        // the copy is just as initialized as the original
+        _materialized = orig->_materialized;
+    }
+
+    /**
+     *  Have the declared properties been initialized?
+     *  @return bool
+     */
+    bool materialized() const
+    {
+        return _materialized;
+    }
+
+    /**
+     *  The snapshot of the properties with callbacks
+     *  @return HashTable   The snapshot, or nullptr if there is none
+     */
+    HashTable *snapshot() const
+    {
+        return _snapshot;
+    }
+
+    /**
+     *  Store a new snapshot of the properties with callbacks
+     *  @param  snapshot    The snapshot, we take over a reference
+     */
+    void snapshot(HashTable *snapshot)
+    {
+        // forget the old one
+        invalidate();
+
+        // store the new one
+        _snapshot = snapshot;
+    }
+
+    /**
+     *  Forget the snapshot (because a property is written)
+     */
+    void invalidate()
+    {
+        // nothing to do if there is no snapshot
+        if (!_snapshot) return;
+
+        // release our reference, the table could still be in use by the engine
+#if PHP_VERSION_ID < 70300
+        if (--GC_REFCOUNT(_snapshot) == 0) zend_array_destroy(_snapshot);
+#else
+        if (GC_DELREF(_snapshot) == 0) zend_array_destroy(_snapshot);
+#endif
+
+        // there is no longer a snapshot
+        _snapshot = nullptr;
+    }
+
     /**
      *  Retrieve the base class of the original C++ object
      *  @return Base
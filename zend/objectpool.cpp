@@ -0,0 +1,147 @@
+/**
+ *  ObjectPool.cpp
+ *
+ *  Implementation of the pool of memory for C++ objects
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+#include <algorithm>
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  All pools that exist (they are all recycled when the request ends)
+ *
+ *  The set is allocated on the heap and never destructed: the pools are
+ *  owned by the classes of the extensions, which are static objects that
+ *  can be destructed after a function-local static set would be gone
+ *
+ *  @return std::set
+ */
+static std::set<ObjectPool*> &pools()
+{
+    // the pools (deliberately leaked)
+    static auto *pools = new std::set<ObjectPool*>();
+
+    // expose them
+    return *pools;
+}
+
+/**
+ *  Constructor
+ *  @param  size        Size of a single object
+ *  @param  count       Number of objects in a slab
+ */
+ObjectPool::ObjectPool(size_t size, size_t count) :
+    _size(std::max(size, sizeof(void*))),
+    _count(std::max(count, (size_t)1)),
+    _used(_count)
+{
+    // register the pool
+    pools().insert(this);
+}
+
+/**
+ *  Destructor
+ */
+ObjectPool::~ObjectPool()
+{
+    // the slabs were already released when the last request ended, and the
+    // zend memory manager is no longer available here, so we only unregister
+    pools().erase(this);
+}
+
+/**
+ *  Allocate memory for an object
+ *  @return void*
+ */
+void *ObjectPool::allocate()
+{
+    // update the statistics
+    _statistics.peak = std::max(_statistics.peak, ++_statistics.live);
+
+    // is there memory of an object that was destructed before?
+    if (_free)
+    {
+        // take it from the free list
+        void *result = _free;
+        _free = *(void **)result;
+
+        // update the statistics
+        _statistics.recycled += 1;
+
+        // done
+        return result;
+    }
+
+    // do we need a new slab?
+    if (_used == _count)
+    {
+        // allocate the slab
+        _slabs.push_back((char *)emalloc(_size * _count));
+        _statistics.slabs = _slabs.size();
+
+        // nothing was used from the slab so far
+        _used = 0;
+    }
+
+    // take the next object from the slab
+    return _slabs.back() + _size * _used++;
+}
+
+/**
+ *  Return the memory of an object to the pool
+ *  @param  object
+ */
+void ObjectPool::release(void *object)
+{
+    // add it to the front of the free list
+    *(void **)object = _free;
+    _free = object;
+
+    // update the statistics
+    _statistics.live -= 1;
+}
+
+/**
+ *  Release all slabs
+ */
+void ObjectPool::recycle()
+{
+    // release all slabs
+    for (auto *slab : _slabs) efree(slab);
+
+    // forget about all memory
+    _slabs.clear();
+    _free = nullptr;
+    _used = _count;
+
+    // update the statistics (the peak is measured per request)
+    _statistics.live = 0;
+    _statistics.peak = 0;
+    _statistics.slabs = 0;
+}
+
+/**
+ *  Recycle all pools
+ *
+ *  The pools of all extensions that are built with PHP-CPP are recycled,
+ *  and not only the pools of the extension that calls this. That is safe:
+ *  this is called from the post-deactivate hook, when the objects of all
+ *  extensions have already been destructed, and recycling a pool a second
+ *  time does nothing.
+ */
+void ObjectPool::recycleAll()
+{
+    // recycle each pool
+    for (auto *pool : pools()) pool->recycle();
+}
+
+/**
+ *  End of namespace
+ */
+}
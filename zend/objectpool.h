@@ -0,0 +1,115 @@
+/**
+ *  ObjectPool.h
+ *
+ *  Pool of memory for the C++ objects of a single class. The memory is
+ *  allocated in slabs that can hold a fixed number of objects, and the
+ *  memory of objects that are destructed is kept in a free list so that it
+ *  can be reused for the next object. The slabs are allocated with the zend
+ *  memory manager, and are released when the request ends.
+ *
+ *  @copyright 2026 Copernica BV
+ */
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Class definition
+ */
+class ObjectPool
+{
+private:
+    /**
+     *  Size of a single object
+     *  @var    size_t
+     */
+    size_t _size;
+
+    /**
+     *  Number of objects in a slab
+     *  @var    size_t
+     */
+    size_t _count;
+
+    /**
+     *  The slabs that are allocated
+     *  @var    std::vector
+     */
+    std::vector<char*> _slabs;
+
+    /**
+     *  Number of objects that were handed out from the last slab
+     *  @var    size_t
+     */
+    size_t _used = 0;
+
+    /**
+     *  The first free object (the first bytes of each free object hold a
+     *  pointer to the next free object)
+     *  @var    void*
+     */
+    void *_free = nullptr;
+
+    /**
+     *  The statistics
+     *  @var    PoolStatistics
+     */
+    PoolStatistics _statistics;
+
+public:
+    /**
+     *  Constructor
+     *  @param  size        Size of a single object
+     *  @param  count       Number of objects in a slab
+     */
+    ObjectPool(size_t size, size_t count);
+
+    /**
+     *  No copying or moving
+     *  @param  that
+     */
+    ObjectPool(const ObjectPool &that) = delete;
+    ObjectPool(ObjectPool &&that) = delete;
+
+    /**
+     *  Destructor
+     */
+    virtual ~ObjectPool();
+
+    /**
+     *  Allocate memory for an object
+     *  @return void*
+     */
+    void *allocate();
+
+    /**
+     *  Return the memory of an object to the pool
+     *  @param  object
+     */
+    void release(void *object);
+
+    /**
+     *  Release all slabs, this is called when the request ends (at that time
+     *  all objects have been destructed)
+     */
+    void recycle();
+
+    /**
+     *  Statistics about the pool
+     *  @return PoolStatistics
+     */
+    const PoolStatistics &statistics() const { return _statistics; }
+
+    /**
+     *  Recycle all pools, of all extensions that use this library (this is
+     *  called after the request has ended, when no object is alive anymore)
+     */
+    static void recycleAll();
+};
+
+/**
+ *  End of namespace
+ */
+}
@@ -0,0 +1,191 @@
+/**
+ *  ParameterView.cpp
+ *
+ *  Implementation of the non-owning view on the arguments of a call
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+#include "numericstring.h"
+
+/**
+ *  Set up namespace
+ */
+namespace Php {
+
+/**
+ *  Constructor
+ *  @param  execute_data    The call frame
+ */
+ParameterView::ParameterView(struct _zend_execute_data *execute_data) :
+    _execute_data(execute_data),
+    _size(ZEND_CALL_NUM_ARGS(execute_data)) {}
+
+/**
+ *  Retrieve the zval holding a certain argument
+ *  @param  index
+ *  @return zval
+ */
+zval *ParameterView::argument(size_t index) const
+{
+    // check for out-of-range indexes
+    if (index >= _size) return nullptr;
+
+    // the arguments are stored right after the call frame (the first argument has number 1)
+    zval *result = ZEND_CALL_ARG(_execute_data, index + 1);
+
+    // we never expose the reference itself
+    ZVAL_DEREF(result);
+
+    // done
+    return result;
+}
+
+/**
+ *  The object that is being called
+ *  @return Base
+ */
+Base *ParameterView::object() const
+{
+    // the object is stored in the call frame (only set for non-static methods)
+    auto *execute_data = _execute_data;
+    zval *object = getThis();
+
+    // find the base object
+    return object ? ObjectImpl::find(object)->object() : nullptr;
+}
+
+/**
+ *  Retrieve a parameter as a Php::Value object
+ *  @param  index
+ *  @return Value
+ */
+Value ParameterView::operator[](size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // wrap it (or return null)
+    return value ? Value(value) : Value();
+}
+
+/**
+ *  Type of a parameter
+ *  @param  index
+ *  @return Type
+ */
+Type ParameterView::type(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // check the type
+    return value ? (Type)Z_TYPE_P(value) : Type::Undefined;
+}
+
+/**
+ *  Retrieve a parameter as integer
+ *  @param  index
+ *  @return int64_t
+ */
+int64_t ParameterView::numericValue(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // leap out if not found
+    if (!value) return 0;
+
+    // convert to an integer (with a shortcut for plain integer strings)
+    return NumericString::toLong(value);
+}
+
+/**
+ *  Retrieve a parameter as boolean
+ *  @param  index
+ *  @return bool
+ */
+bool ParameterView::boolValue(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // apply the regular php rules
+    return value ? zend_is_true(value) : false;
+}
+
+/**
+ *  Retrieve a parameter as floating point number
+ *  @param  index
+ *  @return double
+ */
+double ParameterView::floatValue(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // leap out if not found
+    if (!value) return 0.0;
+
+    // convert to a floating point number (with a shortcut for plain integer strings)
+    return NumericString::toDouble(value);
+}
+
+/**
+ *  Retrieve a parameter as string
+ *  @param  index
+ *  @return std::string
+ */
+std::string ParameterView::stringValue(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // leap out if not found
+    if (!value) return std::string();
+
+    // strings can be copied right away
+    if (Z_TYPE_P(value) == IS_STRING) return std::string(Z_STRVAL_P(value), Z_STRLEN_P(value));
+
+    // convert to a string first
+    zend_string *str = zval_get_string(value);
+    std::string result(ZSTR_VAL(str), ZSTR_LEN(str));
+    zend_string_release(str);
+
+    // done
+    return result;
+}
+
+/**
+ *  Direct access to the buffer of a string parameter
+ *  @param  index
+ *  @return const char *
+ */
+const char *ParameterView::rawValue(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // only strings have a buffer
+    return value && Z_TYPE_P(value) == IS_STRING ? Z_STRVAL_P(value) : nullptr;
+}
+
+/**
+ *  Size of a string parameter
+ *  @param  index
+ *  @return size_t
+ */
+size_t ParameterView::rawSize(size_t index) const
+{
+    // find the argument
+    zval *value = argument(index);
+
+    // only strings have a size
+    return value && Z_TYPE_P(value) == IS_STRING ? Z_STRLEN_P(value) : 0;
+}
+
+/**
+ *  End of namespace
+ */
+}
+
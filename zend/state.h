@@ -81,6 +81,22 @@ public:
      *  @throw Throwable
      */
     void rethrow()
+    {
+        // nothing to do if the exception did not change
+        if (EG(exception) == _exception) return;
+
+        // rethrow the new exception
+        rethrowCurrent();
+    }
+
+    /**
+     *  Rethrow the exception that is now active (if any). This can be used
+     *  instead of a State object when it is already known that no exception
+     *  was active before the call to PHP space.
+     *
+     *  @throw Throwable
+     */
+    static void rethrowCurrent()
     {
         // is an exception now active
         zend_object *current = EG(exception);
@@ -88,9 +104,6 @@ public:
         // if no exception is active
         if (current == nullptr) return;
         
-        // or if the exception did not change
-        if (current == _exception) return;
-        
         // an exception occured, this can be a PHP error or a PHP exception
         if (instanceof(current, zend_ce_error)) throw RethrowableError(current);
         
@@ -4,6 +4,13 @@
  *  Simple wrapper around a zend_string object that
  *  implements RAII. This helps to avoid memory leaks
  *
+ *  The strings that are created by this class are only used for the
+ *  duration of a call (class names, constant names, et cetera), so they
+ *  are allocated with the request memory allocator. This also means that
+ *  a String may never be stored in a static or global variable, because
+ *  the memory is released when the request ends. For hash table lookups
+ *  you do not even need this class: use the zend_hash_str_*() functions.
+ *
  *  @copyright 2016 Copernica B.V.
  */
 
@@ -51,14 +58,14 @@ public:
      *
      *  @param  string  The string to wrap
      */
-    String(const std::string &string) : _string(zend_string_init(string.data(), string.size(), 1)) {}
+    String(const std::string &string) : _string(zend_string_init(string.data(), string.size(), 0)) {}
 
     /**
      *  Constructor
      *
      *  @param  string  The string to wrap
      */
-    String(const char *string) : _string(zend_string_init(string, std::strlen(string), 1)) {}
+    String(const char *string) : _string(zend_string_init(string, std::strlen(string), 0)) {}
 
     /**
      *  Constructor
@@ -66,7 +73,7 @@ public:
      *  @param  string  The string to wrap
      *  @param  size    Number of bytes in the string
      */
-    String(const char *string, size_t size) : _string(zend_string_init(string, size, 1)) {}
+    String(const char *string, size_t size) : _string(zend_string_init(string, size, 0)) {}
 
     /**
      *  Constructor
@@ -74,7 +81,7 @@ public:
      *  @param  string  The string to wrap
      */
     template <size_t size>
-    String(const char (&string)[size]) : _string(zend_string_init(string, size - 1, 1)) {}
+    String(const char (&string)[size]) : _string(zend_string_init(string, size - 1, 0)) {}
 
     /**
      *  Copy constructor
@@ -0,0 +1,94 @@
+/**
+ *  StringFuncs.cpp
+ *
+ *  Native implementations of the PHP string functions that are available
+ *  in the Php namespace (strlen() and implode())
+ *
+ *  @copyright 2026 Copernica BV
+ */
+#include "includes.h"
+#include <zend_smart_str.h>
+
+/**
+ *  Open the PHP namespace
+ */
+namespace Php {
+
+/**
+ *  Length of a string
+ *  @param  value
+ *  @return Value
+ */
+Value strlen(const Value &value)
+{
+    // the actual value
+    zval *input = value._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_STRING) return call("strlen", value);
+
+    // the length is stored in the string
+    return (int64_t)Z_STRLEN_P(input);
+}
+
+/**
+ *  Join the elements of an array into a string
+ *  @param  glue        The separator
+ *  @param  size        Size of the separator
+ *  @param  pieces      The array
+ *  @return Value
+ */
+Value implode(const char *glue, size_t size, const Value &pieces)
+{
+    // the actual array
+    zval *input = pieces._val.dereference();
+
+    // for all other types we let php do the work
+    if (Z_TYPE_P(input) != IS_ARRAY) return call("implode", Value(glue, size), pieces);
+
+    // the string that is being built, and the value of each element
+    smart_str buffer = {0};
+    zval *entry;
+    bool first = true;
+
+    // loop through the elements
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(input), entry)
+    {
+        // dereference the value
+        ZVAL_DEREF(entry);
+
+        // add the separator
+        if (!first) smart_str_appendl(&buffer, glue, size);
+        first = false;
+
+        // strings and integers do not have to be converted
+        if (Z_TYPE_P(entry) == IS_STRING) smart_str_append(&buffer, Z_STR_P(entry));
+        else if (Z_TYPE_P(entry) == IS_LONG) smart_str_append_long(&buffer, Z_LVAL_P(entry));
+        else
+        {
+            // convert the value to a string first
+            zend_string *str = zval_get_string(entry);
+            smart_str_append(&buffer, str);
+            zend_string_release(str);
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    // the result value
+    Value result;
+
+    // an empty array results in an empty string
+    if (!buffer.s) { ZVAL_EMPTY_STRING(result._val); return result; }
+
+    // terminate the string, and pass ownership to the result
+    smart_str_0(&buffer);
+    ZVAL_NEW_STR(result._val, buffer.s);
+
+    // done
+    return result;
+}
+
+/**
+ *  End of namespace
+ */
+}
@@ -27,6 +27,7 @@
 #include "includes.h"
 #include "string.h"
 #include "lowercase.h"
+#include "numericstring.h"
 #include "macros.h"
 #include "execarguments.h"
 
@@ -620,6 +621,17 @@ Value &Value::operator=(const HashMember<int> &value)
     return operator=(value.value());
 }
 
+/**
+ *  Assignment operator
+ *  @param  value
+ *  @return Value
+ */
+Value &Value::operator=(const HashMember<Key> &value)
+{
+    // assign value object
+    return operator=(value.value());
+}
+
 /**
  *  Add a value to the object
  *  @param  value
@@ -1297,7 +1309,8 @@ Value Value::clone(Type type) const
  */
 int64_t Value::numericValue() const
 {
-    return zval_get_long(_val);
+    // convert to an integer (with a shortcut for plain integer strings)
+    return NumericString::toLong(_val);
 }
 
 /**
@@ -1327,6 +1340,10 @@ bool Value::boolValue() const
  */
 std::string Value::stringValue() const
 {
+    // strings can be copied right away
+    if (Z_TYPE_P(_val) == IS_STRING) return std::string(Z_STRVAL_P(_val), Z_STRLEN_P(_val));
+
+    // convert to a string first
     zend_string* s  = zval_get_string(_val);
     std::string ret(ZSTR_VAL(s), ZSTR_LEN(s));
     zend_string_release(s);
@@ -1394,7 +1411,8 @@ int Value::strcmp(const char *value) const
  */
 double Value::floatValue() const
 {
-    return zval_get_double(_val);
+    // convert to a floating point number (with a shortcut for plain integer strings)
+    return NumericString::toDouble(_val);
 }
 
 /**
@@ -1518,12 +1536,32 @@ ValueIterator Value::end() const
     return createIterator(false);
 }
 
+/**
+ *  Return a non-owning view on the elements of an array
+ *  @return HashView
+ */
+HashView Value::items() const
+{
+    // only arrays have elements that can be viewed
+    return HashView(isArray() ? Z_ARRVAL_P(_val.dereference()) : nullptr);
+}
+
 /**
  *  Iterate over key value pairs
  *  @param  callback
  */
 void Value::iterate(const std::function<void(const Php::Value &,const Php::Value &)> &callback) const
 {
+    // arrays can be iterated without allocating an iterator
+    if (isArray())
+    {
+        // iterate over the elements
+        for (const auto &entry : items()) callback(entry.key.value(), entry.value.value());
+
+        // done
+        return;
+    }
+
     // iterate over the object
     for (const auto &iter : *this)
     {
@@ -1564,7 +1602,7 @@ bool Value::contains(const char *key, int size) const
     if (isArray())
     {
         // check if index is already in the array
-        return zend_hash_find(Z_ARRVAL_P(_val.dereference()), String(key, size)) != nullptr;
+        return zend_hash_str_find(Z_ARRVAL_P(_val.dereference()), key, size) != nullptr;
     }
     else if (isObject())
     {
@@ -1647,7 +1685,7 @@ Value Value::get(const char *key, int size) const
     if (isArray())
     {
         // find the result
-        auto val = zend_hash_find(Z_ARRVAL_P(_val.dereference()), String(key, size));
+        auto val = zend_hash_str_find(Z_ARRVAL_P(_val.dereference()), key, size);
 
         // wrap it in a value if it isn't null, otherwise return an empty value
         return val ? Value(val) : Value();
@@ -1722,6 +1760,324 @@ void Value::set(int index, const Value &value)
     setRaw(index, value);
 }
 
+/**
+ *  Set a certain property by moving a value into the array
+ *  @param  index
+ *  @param  value
+ */
+void Value::set(int index, Value &&value)
+{
+    // objects can not take over the value
+    if (isObject()) return set(index, static_cast<const Value &>(value));
+
+    // the array takes over the reference, the value is left undefined
+    zend_hash_index_update(Z_ARRVAL_P(writable()), index, value._val);
+    ZVAL_UNDEF(value._val);
+}
+
+/**
+ *  Add an element to the end of the array
+ *  @param  value
+ */
+void Value::push_back(const Value &value)
+{
+    // objects can only handle this if they implement ArrayAccess
+    if (isObject())
+    {
+        // other objects can not be used as an array, just like in php
+        if (!instanceOf("ArrayAccess")) throw Error(std::string("Cannot use object of type ") + ZSTR_VAL(Z_OBJCE_P(_val.dereference())->name) + " as array");
+
+        // same as $object[] = $value
+        call("offsetSet", nullptr, value);
+        return;
+    }
+
+    // the variable gets one more reference (the array entry), this is done before
+    // the array is separated, so that pushing the same array stores a copy of it
+    // (the value can even be this same variable, so we hold on to our own zval)
+    zval element;
+    ZVAL_COPY(&element, value._val);
+
+    // add the value, this fails when the highest possible index is already in use
+    if (zend_hash_next_index_insert(Z_ARRVAL_P(writable()), &element)) return;
+
+    // the reference was not taken after all (if the array was separated, this
+    // can be the last reference to the old array, so it is properly destructed)
+    zval_ptr_dtor(&element);
+
+    // report an error
+    throw Error("Cannot add element to the array as the next element is already occupied");
+}
+
+/**
+ *  Move an element to the end of the array
+ *  @param  value
+ */
+void Value::push_back(Value &&value)
+{
+    // objects can not take over the value
+    if (isObject()) return push_back(static_cast<const Value &>(value));
+
+    // add the value, this fails when the highest possible index is already in use
+    if (!zend_hash_next_index_insert(Z_ARRVAL_P(writable()), value._val)) throw Error("Cannot add element to the array as the next element is already occupied");
+
+    // the array took over the reference, the value is left undefined
+    ZVAL_UNDEF(value._val);
+}
+
+/**
+ *  Turn the (null) value into an empty packed array
+ *  @param  size        Number of elements
+ *  @return bool        Was packed storage allocated (false for empty arrays)
+ */
+bool Value::initPacked(size_t size)
+{
+    // create the array
+    array_init_size(_val, size);
+
+    // nothing to allocate if there are no elements, the table stays
+    // uninitialized and must not be filled with ZEND_HASH_FILL_PACKED
+    if (size == 0) return false;
+
+    // allocate the packed storage up front
+#if PHP_VERSION_ID >= 70300
+    zend_hash_real_init_packed(Z_ARRVAL_P(_val));
+#else
+    zend_hash_real_init(Z_ARRVAL_P(_val), 1);
+#endif
+
+    // the buckets can now be filled
+    return true;
+}
+
+/**
+ *  Fill the (null) value with a buffer of integers
+ *  @param  data
+ *  @param  size
+ */
+void Value::assign(const int64_t *data, size_t size)
+{
+    // create the array, an empty array has nothing to fill
+    if (!initPacked(size)) return;
+
+    // write the elements straight into the buckets
+    ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(_val))
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            zval element;
+            ZVAL_LONG(&element, data[i]);
+            ZEND_HASH_FILL_ADD(&element);
+        }
+    }
+    ZEND_HASH_FILL_END();
+}
+
+/**
+ *  Fill the (null) value with a buffer of doubles
+ *  @param  data
+ *  @param  size
+ */
+void Value::assign(const double *data, size_t size)
+{
+    // create the array, an empty array has nothing to fill
+    if (!initPacked(size)) return;
+
+    // write the elements straight into the buckets
+    ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(_val))
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            zval element;
+            ZVAL_DOUBLE(&element, data[i]);
+            ZEND_HASH_FILL_ADD(&element);
+        }
+    }
+    ZEND_HASH_FILL_END();
+}
+
+/**
+ *  Fill the (null) value with the elements of a vector of booleans
+ *  @param  input
+ */
+void Value::assign(const std::vector<bool> &input)
+{
+    // create the array, an empty array has nothing to fill
+    if (!initPacked(input.size())) return;
+
+    // write the elements straight into the buckets
+    ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(_val))
+    {
+        for (bool value : input)
+        {
+            zval element;
+            ZVAL_BOOL(&element, value);
+            ZEND_HASH_FILL_ADD(&element);
+        }
+    }
+    ZEND_HASH_FILL_END();
+}
+
+/**
+ *  Fill the (null) value with the elements of a vector of strings
+ *  @param  input
+ */
+void Value::assign(const std::vector<std::string> &input)
+{
+    // create the array, an empty array has nothing to fill
+    if (!initPacked(input.size())) return;
+
+    // write the elements straight into the buckets
+    ZEND_HASH_FILL_PACKED(Z_ARRVAL_P(_val))
+    {
+        for (auto &value : input)
+        {
+            zval element;
+            ZVAL_STRINGL(&element, value.data(), value.size());
+            ZEND_HASH_FILL_ADD(&element);
+        }
+    }
+    ZEND_HASH_FILL_END();
+}
+
+/**
+ *  Helper function to get the zval at a certain position in a packed table
+ *  @param  table
+ *  @param  index
+ *  @return zval
+ */
+static inline zval *packed(HashTable *table, uint32_t index)
+{
+#if PHP_VERSION_ID >= 80200
+    return &table->arPacked[index];
+#else
+    return &table->arData[index].val;
+#endif
+}
+
+/**
+ *  Helper functions to read a number from a zval of the right type, and
+ *  to convert a zval of any other type
+ *  @param  value
+ *  @param  result
+ */
+static inline void load(zval *value, int64_t &result) { result = Z_LVAL_P(value); }
+static inline void load(zval *value, double &result) { result = Z_DVAL_P(value); }
+static inline void convert(zval *value, int64_t &result) { ZVAL_DEREF(value); result = zval_get_long(value); }
+static inline void convert(zval *value, double &result) { ZVAL_DEREF(value); result = zval_get_double(value); }
+
+/**
+ *  Helper function to copy the elements of an array into a buffer
+ *  @param  input       The array
+ *  @param  buffer      The buffer to fill
+ *  @param  size        Size of the buffer
+ *  @param  type        The zval type that does not need a conversion
+ *  @return size_t      Number of elements copied
+ */
+template <typename T>
+static size_t copy(zval *input, T *buffer, size_t size, int type)
+{
+    // the hash table
+    HashTable *table = Z_ARRVAL_P(input);
+
+    // number of elements to copy
+    size_t count = std::min(size, (size_t)zend_hash_num_elements(table));
+
+    // for lists we can read the zvals one after the other
+    if (HashView(table).isList())
+    {
+        // check the types first: this loop has no early exit and no
+        // dependencies between iterations, so that the compiler is free
+        // to vectorize it
+        bool homogeneous = true;
+        for (uint32_t i = 0; i < count; ++i) homogeneous &= Z_TYPE_P(packed(table, i)) == type;
+
+        // if all elements have the right type, they are copied without any checks
+        if (homogeneous)
+        {
+            for (uint32_t i = 0; i < count; ++i) load(packed(table, i), buffer[i]);
+            return count;
+        }
+    }
+
+    // number of elements already copied, and the value of each element
+    size_t copied = 0;
+    zval *entry;
+
+    // loop through the elements in the order of the array
+    ZEND_HASH_FOREACH_VAL(table, entry)
+    {
+        // stop when the buffer is full
+        if (copied >= count) break;
+
+        // convert the element
+        if (Z_TYPE_P(entry) == type) load(entry, buffer[copied++]);
+        else convert(entry, buffer[copied++]);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    // done
+    return copied;
+}
+
+/**
+ *  Copy the elements of an array into a buffer of integers
+ *  @param  buffer
+ *  @param  size
+ *  @return size_t
+ */
+size_t Value::copyTo(int64_t *buffer, size_t size) const
+{
+    // the actual value
+    zval *input = _val.dereference();
+
+    // only arrays have elements
+    return Z_TYPE_P(input) == IS_ARRAY ? copy(input, buffer, size, IS_LONG) : 0;
+}
+
+/**
+ *  Copy the elements of an array into a buffer of doubles
+ *  @param  buffer
+ *  @param  size
+ *  @return size_t
+ */
+size_t Value::copyTo(double *buffer, size_t size) const
+{
+    // the actual value
+    zval *input = _val.dereference();
+
+    // only arrays have elements
+    return Z_TYPE_P(input) == IS_ARRAY ? copy(input, buffer, size, IS_DOUBLE) : 0;
+}
+
+/**
+ *  Create an array holding the numbers in a buffer
+ *  @param  data
+ *  @param  size
+ *  @return Value
+ */
+Value Value::fromSpan(const int64_t *data, size_t size)
+{
+    // construct the array
+    Value result;
+    result.assign(data, size);
+    return result;
+}
+
+/**
+ *  Create an array holding the numbers in a buffer
+ *  @param  data
+ *  @param  size
+ *  @return Value
+ */
+Value Value::fromSpan(const double *data, size_t size)
+{
+    // construct the array
+    Value result;
+    result.assign(data, size);
+    return result;
+}
+
 /**
  *  Set a certain property without running any checks
  *  @param  key
@@ -1778,7 +2134,7 @@ void Value::set(const char *key, int size, const Value &value)
     zval *current;
 
     // check if this index is already in the array, otherwise we return NULL
-    if (isArray() && (current = zend_hash_find(Z_ARRVAL_P(_val.dereference()), String(key, size))))
+    if (isArray() && (current = zend_hash_str_find(Z_ARRVAL_P(_val.dereference()), key, size)))
     {
         // skip if nothing is going to change
         if (value._val == current) return;
@@ -1791,6 +2147,25 @@ void Value::set(const char *key, int size, const Value &value)
     setRaw(key, size, value);
 }
 
+/**
+ *  Set a certain property by moving a value into the array
+ *  @param  key
+ *  @param  size
+ *  @param  value
+ */
+void Value::set(const char *key, int size, Value &&value)
+{
+    // objects can not take over the value
+    if (isObject()) return set(key, size, static_cast<const Value &>(value));
+
+    // does not work for empty keys
+    if (!key || (size > 0 && key[0] == 0)) return;
+
+    // the array takes over the reference, the value is left undefined
+    zend_symtable_str_update(Z_ARRVAL_P(writable()), key, size, value._val);
+    ZVAL_UNDEF(value._val);
+}
+
 /**
  *  Unset a member by its index
  *  @param  index
@@ -1829,10 +2204,96 @@ void Value::unset(const char *key, int size)
         SEPARATE_ZVAL_IF_NOT_REF(_val);
 
         // remove the index
-        zend_hash_del(Z_ARRVAL_P(_val.dereference()), String(key, size));
+        zend_hash_str_del(Z_ARRVAL_P(_val.dereference()), key, size);
     }
 }
 
+/**
+ *  Does the array contain a key with a precalculated hash?
+ *  @param  key
+ *  @return bool
+ */
+bool Value::contains(const Key &key) const
+{
+    // look up the bucket for arrays, objects are handled the regular way
+    if (isArray()) return find(Z_ARRVAL_P(_val.dereference()), key) != nullptr;
+    return contains(key.data(), key.size());
+}
+
+/**
+ *  Get access to a member by a key with a precalculated hash
+ *  @param  key
+ *  @return Value
+ */
+Value Value::get(const Key &key) const
+{
+    // objects (and other types) are handled the regular way
+    if (!isArray()) return get(key.data(), key.size());
+
+    // find the result
+    auto *val = find(Z_ARRVAL_P(_val.dereference()), key);
+
+    // wrap it in a value if it isn't null, otherwise return an empty value
+    return val ? Value(val) : Value();
+}
+
+/**
+ *  Overwrite the value at a key with a precalculated hash
+ *  @param  key
+ *  @param  value
+ */
+void Value::set(const Key &key, const Value &value)
+{
+    // objects are handled the regular way
+    if (isObject()) return set(key.data(), key.size(), value);
+
+    // take a reference to the value before the array is separated, so that
+    // assigning the same array stores a copy instead of a cycle
+    Value copy(value);
+
+    // store the value in the array (which is created if needed)
+    update(writable(), key, copy);
+}
+
+/**
+ *  Retrieve the array for writing elements in place
+ *  @return zval
+ */
+zval *Value::writable()
+{
+    // objects can not be written in place
+    if (isObject()) return nullptr;
+
+    // this should be an array
+    if (!isArray()) setType(Type::Array);
+
+    // the actual array, separated from other copies
+    zval *array = _val.dereference();
+    SEPARATE_ARRAY(array);
+
+    // done
+    return array;
+}
+
+/**
+ *  Unset a member by a key with a precalculated hash
+ *  @param  key
+ */
+void Value::unset(const Key &key)
+{
+    // objects are handled the regular way
+    if (!isArray()) return unset(key.data(), key.size());
+
+    // nothing to do if the key does not exist
+    if (!find(Z_ARRVAL_P(_val.dereference()), key)) return;
+
+    // if this is not a reference variable, we should detach it to implement copy on write
+    SEPARATE_ZVAL_IF_NOT_REF(_val);
+
+    // remove the element (numeric strings are stored as numeric keys)
+    zend_symtable_str_del(Z_ARRVAL_P(_val.dereference()), key.data(), key.size());
+}
+
 /**
  *  Array access operator
  *  This can be used for accessing arrays
@@ -1862,7 +2323,7 @@ HashMember<Value> Value::operator[](const Value &key)
  */
 HashMember<std::string> Value::operator[](const std::string &key)
 {
-    return HashMember<std::string>(this, key);
+    return HashMember<std::string>(this, Key(key.data(), key.size()));
 }
 
 /**
@@ -1873,7 +2334,17 @@ HashMember<std::string> Value::operator[](const std::string &key)
  */
 HashMember<std::string> Value::operator[](const char *key)
 {
-    return HashMember<std::string>(this, key);
+    return HashMember<std::string>(this, Key(key, ::strlen(key)));
+}
+
+/**
+ *  Array access operator with a key that has a precalculated hash
+ *  @param  key
+ *  @return HashMember
+ */
+HashMember<Key> Value::operator[](const Key &key)
+{
+    return HashMember<Key>(this, key);
 }
 
 /**
@@ -103,6 +103,67 @@ void ZendCallable::yield(struct _zval_struct *return_value, const Php::Value &va
     RETVAL_ZVAL(value._val, 1, 0);
 }
 
+/**
+ *  Yield (return) the given value
+ *
+ *  @param  return_value    The return_value to set
+ *  @param  value           The value to return to PHP
+ */
+void ZendCallable::yield(struct _zval_struct *return_value, bool value)
+{
+    // set the return value to a boolean
+    RETVAL_BOOL(value);
+}
+
+/**
+ *  Yield (return) the given value
+ *
+ *  @param  return_value    The return_value to set
+ *  @param  value           The value to return to PHP
+ */
+void ZendCallable::yield(struct _zval_struct *return_value, int64_t value)
+{
+    // set the return value to an integer
+    RETVAL_LONG(value);
+}
+
+/**
+ *  Yield (return) the given value
+ *
+ *  @param  return_value    The return_value to set
+ *  @param  value           The value to return to PHP
+ */
+void ZendCallable::yield(struct _zval_struct *return_value, double value)
+{
+    // set the return value to a floating point number
+    RETVAL_DOUBLE(value);
+}
+
+/**
+ *  Yield (return) the given value
+ *
+ *  @param  return_value    The return_value to set
+ *  @param  value           The value to return to PHP
+ */
+void ZendCallable::yield(struct _zval_struct *return_value, const std::string &value)
+{
+    // pass on to the buffer based implementation
+    yield(return_value, value.data(), value.size());
+}
+
+/**
+ *  Yield (return) the given value
+ *
+ *  @param  return_value    The return_value to set
+ *  @param  buffer          The string to return to PHP
+ *  @param  size            Size of the buffer
+ */
+void ZendCallable::yield(struct _zval_struct *return_value, const char *buffer, size_t size)
+{
+    // copy the buffer into a new string
+    RETVAL_STRINGL(buffer, size);
+}
+
 /**
  *  End namespace
  */